@@ -62,7 +62,6 @@ Input	    Output
 #include <algorithm>
 #include <limits>
 #include <string>
-#include <unordered_map>
 
 class Graph {
  protected:
@@ -141,48 +140,6 @@ class GraphAdjList : public Graph {
   }
 };
 
-template<typename T>
-class DSU {
- private:
-  std::unordered_map<T, size_t> rank_;
-  std::unordered_map<T, T> predecessors_;
-
-  T FindSet(const T &x) {
-    if (x == predecessors_[x]) {
-      return x;
-    }
-    return predecessors_[x] = FindSet(predecessors_[x]);
-  }
-
- public:
-  explicit DSU(const std::vector<T> &elements) {
-    for (int i = 0; i < elements.size(); ++i) {
-      predecessors_[elements[i]] = elements[i];
-      rank_[elements[i]] = 0;
-    }
-  }
-
-  void Union(const T &x, const T &y) {
-    T x_predecessor = FindSet(x);
-    T y_predecessor = FindSet(y);
-
-    if (x_predecessor == y_predecessor) {
-      return;
-    }
-    if (rank_[x_predecessor] < rank_[y_predecessor]) {
-      std::swap(x_predecessor, y_predecessor);
-    }
-    predecessors_[y_predecessor] = x_predecessor;
-    if (rank_[x_predecessor] == rank_[y_predecessor]) {
-      ++rank_[x_predecessor];
-    }
-  }
-
-  bool InSameSet(const T &x, const T &y) {
-    return FindSet(x) == FindSet(y);
-  }
-};
-
 namespace GraphProcessing {
 
   const size_t INF = std::numeric_limits<size_t>::max();
@@ -206,22 +163,39 @@ namespace GraphProcessing {
 
   typedef std::priority_queue<Distance_Vertex, std::vector<Distance_Vertex>, std::greater<>> PriorityQueue;
 
-  void Relax(const Graph &graph, std::vector<size_t> &min_distance, const Graph::Vertex &neighbor,
+  const Graph::Vertex NOT_SET = std::numeric_limits<Graph::Vertex>::max();
+
+  // For every vertex: distance to the nearest start, that start and the last edge of the shortest path to it.
+  struct ShortestPathForest {
+    std::vector<size_t> min_distance;
+    std::vector<Graph::Vertex> nearest_source;
+    std::vector<Graph::Edge> parent_edge;
+
+    explicit ShortestPathForest(size_t vertex_count)
+        : min_distance(vertex_count, INF),
+          nearest_source(vertex_count, NOT_SET),
+          parent_edge(vertex_count, {NOT_SET, NOT_SET, 0}) {}
+  };
+
+  void Relax(const Graph &graph, ShortestPathForest &forest, const Graph::Vertex &neighbor,
              const Graph::Vertex &vertex, PriorityQueue &priority_queue) {
     size_t weight = graph.GetWeight(vertex, neighbor);
-    if (min_distance[neighbor] > weight + min_distance[vertex]) {
-      min_distance[neighbor] = weight + min_distance[vertex];
-      priority_queue.push({min_distance[neighbor], neighbor});
+    if (forest.min_distance[neighbor] > weight + forest.min_distance[vertex]) {
+      forest.min_distance[neighbor] = weight + forest.min_distance[vertex];
+      forest.nearest_source[neighbor] = forest.nearest_source[vertex];
+      forest.parent_edge[neighbor] = {vertex, neighbor, weight};
+      priority_queue.push({forest.min_distance[neighbor], neighbor});
     }
   }
 
-  std::vector<size_t> GetMinDistances_Dijkstra(const Graph &graph, const std::vector<Graph::Vertex> &starts) {
+  ShortestPathForest GetShortestPathForest_Dijkstra(const Graph &graph, const std::vector<Graph::Vertex> &starts) {
     const size_t vertex_count = graph.GetVertexCount();
-    std::vector<size_t> min_distance(vertex_count, INF);
+    ShortestPathForest forest(vertex_count);
     std::vector<bool> visited(vertex_count, false);
     PriorityQueue priority_queue;
     for (auto start : starts) {
-      min_distance[start] = 0;
+      forest.min_distance[start] = 0;
+      forest.nearest_source[start] = start;
       priority_queue.push({0, start});
     }
     while (!priority_queue.empty()) {
@@ -232,63 +206,141 @@ namespace GraphProcessing {
       }
       visited[vertex] = true;
       for (const auto &neighbor : graph.GetAllNeighbors(vertex)) {
-        Relax(graph, min_distance, neighbor, vertex, priority_queue);
+        Relax(graph, forest, neighbor, vertex, priority_queue);
       }
     }
-    return min_distance;
+    return forest;
+  }
+
+  std::vector<size_t> GetMinDistances_Dijkstra(const Graph &graph, const std::vector<Graph::Vertex> &starts) {
+    return GetShortestPathForest_Dijkstra(graph, starts).min_distance;
   }
 }
 
-struct PathInfo {
-  Graph::Edge edge;
-  int id;
-  bool is_graph_edge;
+////////////////////////////// class KruskalReconstructionTree //////////////////////////////
 
-  bool operator<(const PathInfo &path_info) const {
-    return edge.weight < path_info.edge.weight || (edge.weight == path_info.edge.weight && id < path_info.id);
-  }
+/* Every union of Kruskal's algorithm creates a new tree node whose children are the two merged components
+ and whose weight is the weight of the merging edge. The maximum edge on the minimax path between two
+ vertices is then the weight of their lowest common ancestor, which is found with binary lifting. */
+class KruskalReconstructionTree {
+ private:
+  typedef Graph::Vertex Vertex;
+
+  std::vector<size_t> node_weight_;
+  std::vector<size_t> depth_;
+  std::vector<std::vector<Vertex>> ancestors_;
+
+  static Vertex FindComponentTop(std::vector<Vertex> &component_top, Vertex vertex);
+  Vertex GetLCA(Vertex first, Vertex second) const;
+
+ public:
+  static constexpr Vertex NOT_CONNECTED = std::numeric_limits<size_t>::max();
+
+  explicit KruskalReconstructionTree(size_t vertex_count, std::vector<Graph::Edge> edges);
+  size_t GetBottleneck(const Vertex &start, const Vertex &finish) const;
+  bool CanMove(const Vertex &start, const Vertex &finish, size_t max_edge_weight) const;
+};
 
-  bool operator==(const PathInfo &path_info) const {
-    return edge.weight == path_info.edge.weight && id == path_info.id;
+KruskalReconstructionTree::KruskalReconstructionTree(size_t vertex_count, std::vector<Graph::Edge> edges)
+    : node_weight_(vertex_count, 0) {
+  std::sort(edges.begin(), edges.end());
+  std::vector<Vertex> parent(vertex_count);
+  std::vector<Vertex> component_top(vertex_count);
+  for (Vertex vertex = 0; vertex < vertex_count; ++vertex) {
+    parent[vertex] = component_top[vertex] = vertex;
+  }
+  for (const auto &edge : edges) {
+    Vertex from_top = FindComponentTop(component_top, edge.from);
+    Vertex to_top = FindComponentTop(component_top, edge.to);
+    if (from_top == to_top) {
+      continue;
+    }
+    Vertex new_node = node_weight_.size();
+    node_weight_.push_back(edge.weight);
+    parent.push_back(new_node);
+    component_top.push_back(new_node);
+    parent[from_top] = parent[to_top] = new_node;
+    component_top[from_top] = component_top[to_top] = new_node;
   }
 
-  bool operator>(const PathInfo &path_info) const {
-    return !(*this < path_info || *this == path_info);
+  const size_t nodes_count = node_weight_.size();
+  depth_.assign(nodes_count, 0);
+  for (Vertex node = nodes_count; node-- > 0;) {
+    if (parent[node] != node) {
+      depth_[node] = depth_[parent[node]] + 1;
+    }
   }
-};
+  ancestors_.push_back(std::move(parent));
+  for (size_t jump = 2; jump < nodes_count; jump *= 2) {
+    const auto &prev_level = ancestors_.back();
+    std::vector<Vertex> next_level(nodes_count);
+    for (Vertex node = 0; node < nodes_count; ++node) {
+      next_level[node] = prev_level[prev_level[node]];
+    }
+    ancestors_.push_back(std::move(next_level));
+  }
+}
 
-std::vector<Graph::Vertex> GenerateVerticesVector(size_t vector_size) {
-  std::vector<Graph::Vertex> vertices(vector_size);
-  Graph::Vertex vertex(1);
-  std::generate(vertices.begin(), vertices.end(), [&vertex] {
-    return vertex++;
-  });
-  return vertices;
+KruskalReconstructionTree::Vertex KruskalReconstructionTree::FindComponentTop(std::vector<Vertex> &component_top,
+                                                                              Vertex vertex) {
+  Vertex top = vertex;
+  while (component_top[top] != top) {
+    top = component_top[top];
+  }
+  while (component_top[vertex] != top) {
+    Vertex next = component_top[vertex];
+    component_top[vertex] = top;
+    vertex = next;
+  }
+  return top;
 }
 
-std::vector<bool> PossibilityToMoveFromStartToFinish(const Graph &graph, const std::vector<Graph::Vertex> &gas_stations,
-                                                     const size_t quires_num, const std::vector<Graph::Edge> &edges,
-                                                     std::priority_queue<PathInfo, std::vector<PathInfo>,
-                                                                         std::greater<>> &path_info) {
-  int NOT_SET = -1;
-  auto min_distances = GraphProcessing::GetMinDistances_Dijkstra(graph, gas_stations);
-  for (const auto &edge : edges) {
-    path_info.push({{edge.from, edge.to, edge.weight + min_distances[edge.from] + min_distances[edge.to]}, NOT_SET,
-                    true});
+KruskalReconstructionTree::Vertex KruskalReconstructionTree::GetLCA(Vertex first, Vertex second) const {
+  if (depth_[first] < depth_[second]) {
+    std::swap(first, second);
+  }
+  for (size_t level = ancestors_.size(); level-- > 0;) {
+    if (depth_[first] - depth_[second] >= (1u << level)) {
+      first = ancestors_[level][first];
+    }
   }
+  if (first == second) {
+    return first;
+  }
+  for (size_t level = ancestors_.size(); level-- > 0;) {
+    if (ancestors_[level][first] != ancestors_[level][second]) {
+      first = ancestors_[level][first];
+      second = ancestors_[level][second];
+    }
+  }
+  return (ancestors_[0][first] == ancestors_[0][second]) ? ancestors_[0][first] : NOT_CONNECTED;
+}
+
+size_t KruskalReconstructionTree::GetBottleneck(const Vertex &start, const Vertex &finish) const {
+  Vertex lca = GetLCA(start, finish);
+  return (lca == NOT_CONNECTED) ? NOT_CONNECTED : node_weight_[lca];
+}
+
+bool KruskalReconstructionTree::CanMove(const Vertex &start, const Vertex &finish, size_t max_edge_weight) const {
+  size_t bottleneck = GetBottleneck(start, finish);
+  return bottleneck != NOT_CONNECTED && bottleneck <= max_edge_weight;
+}
 
-  DSU<Graph::Vertex> dsu(GenerateVerticesVector(graph.GetVertexCount()));
-  std::vector<bool> possibility_to_move_from_start_to_finish(quires_num);
-  while (!path_info.empty()) {
-    auto edge_info = path_info.top();
-    path_info.pop();
-    if (!edge_info.is_graph_edge) {
-      possibility_to_move_from_start_to_finish[edge_info.id] = dsu.InSameSet(edge_info.edge.to, edge_info.edge.from);
-    } else {
-      dsu.Union(edge_info.edge.to, edge_info.edge.from);
+////////////////////////////////////////////////////////////////////////////////
+
+KruskalReconstructionTree BuildStationsTree(const Graph &graph, const std::vector<Graph::Vertex> &gas_stations,
+                                            const std::vector<Graph::Edge> &edges) {
+  auto forest = GraphProcessing::GetShortestPathForest_Dijkstra(graph, gas_stations);
+  std::vector<Graph::Edge> stations_edges;
+  for (const auto &edge : edges) {
+    Graph::Vertex from_station = forest.nearest_source[edge.from];
+    Graph::Vertex to_station = forest.nearest_source[edge.to];
+    if (from_station != to_station && from_station != GraphProcessing::NOT_SET) {
+      stations_edges.push_back({from_station, to_station,
+                                edge.weight + forest.min_distance[edge.from] + forest.min_distance[edge.to]});
     }
   }
-  return possibility_to_move_from_start_to_finish;
+  return KruskalReconstructionTree(graph.GetVertexCount(), std::move(stations_edges));
 }
 
 int main() {
@@ -299,7 +351,6 @@ int main() {
   std::cin >> vertex_num >> gas_station_num >> edges_num;
 
   std::vector<Graph::Vertex> gas_stations(gas_station_num);
-  std::priority_queue<PathInfo, std::vector<PathInfo>, std::greater<>> path_info;
   std::vector<Graph::Edge> edges;
   for (size_t i = 0; i < gas_station_num; ++i) {
     std::cin >> gas_stations[i];
@@ -317,20 +368,15 @@ int main() {
     edges.push_back({start, finish, weight});
   }
 
+  KruskalReconstructionTree stations_tree = BuildStationsTree(graph_adj_list, gas_stations, edges);
   size_t queries_num;
   std::cin >> queries_num;
   for (size_t i = 0; i < queries_num; ++i) {
     Graph::Vertex start, finish;
-    size_t weight;
-    std::cin >> start >> finish >> weight;
-    path_info.push({{start - 1, finish - 1, weight}, static_cast<int>(i), false});
-  }
-
-  std::vector<bool> result =
-      PossibilityToMoveFromStartToFinish(graph_adj_list, gas_stations, queries_num, edges, path_info);
-  for (const auto &res : result) {
-    std::cout << (res ? "TAK" : "NIE") << std::endl;
+    size_t tank_volume;
+    std::cin >> start >> finish >> tank_volume;
+    std::cout << (stations_tree.CanMove(start - 1, finish - 1, tank_volume) ? "TAK" : "NIE") << '\n';
   }
 
   return 0;
-}
\ No newline at end of file
+}
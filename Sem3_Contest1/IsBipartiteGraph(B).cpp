@@ -22,6 +22,7 @@ Output format
 #include <iostream>
 #include <vector>
 #include <algorithm>
+#include <limits>
 
 class Graph {
  protected:
@@ -75,15 +76,27 @@ namespace GraphProcessing {
     NOT_SET
   };
 
-  bool DFS(const Graph &graph, std::vector<Group> &group_status, const Graph::Vertex &vertex) {
-    Group neighbor_group = (group_status[vertex] == FIRST ? SECOND : FIRST);
-    for (auto neighbor : graph.GetAllNeighbors(vertex)) {
-      if (group_status[neighbor] == group_status[vertex]) {
-        return false;
-      } else if (group_status[neighbor] == NOT_SET) {
-        group_status[neighbor] = neighbor_group;
-        if (!DFS(graph, group_status, neighbor)) {
-          return false;
+  // Iterative DFS coloring; returns false as soon as an edge inside one group is found.
+  bool GetBipartition(const Graph &graph, std::vector<Group> &group_status) {
+    group_status.assign(graph.GetVertexCount() + 1, NOT_SET);
+    std::vector<Graph::Vertex> stack;
+    for (Graph::Vertex start = 1; start < graph.GetVertexCount() + 1; ++start) {
+      if (group_status[start] != NOT_SET) {
+        continue;
+      }
+      group_status[start] = FIRST;
+      stack.push_back(start);
+      while (!stack.empty()) {
+        Graph::Vertex vertex = stack.back();
+        stack.pop_back();
+        Group neighbor_group = (group_status[vertex] == FIRST ? SECOND : FIRST);
+        for (auto neighbor : graph.GetAllNeighbors(vertex)) {
+          if (group_status[neighbor] == group_status[vertex]) {
+            return false;
+          } else if (group_status[neighbor] == NOT_SET) {
+            group_status[neighbor] = neighbor_group;
+            stack.push_back(neighbor);
+          }
         }
       }
     }
@@ -91,16 +104,121 @@ namespace GraphProcessing {
   }
 
   bool IsBipartiteGraph(const Graph &graph) {
-    std::vector<Group> group_status(graph.GetVertexCount() + 1, NOT_SET);
-    for (Graph::Vertex vertex = 1; vertex < graph.GetVertexCount() + 1; ++vertex) {
-      if (group_status[vertex] == NOT_SET) {
-        group_status[vertex] = FIRST;
-        if (!DFS(graph, group_status, vertex)) {
-          return false;
+    std::vector<Group> group_status;
+    return GetBipartition(graph, group_status);
+  }
+
+  // Edges from the FIRST group to the SECOND one in compressed sparse row form.
+  struct BipartiteGraphCSR {
+    std::vector<Graph::Vertex> left_vertices;
+    std::vector<size_t> offsets;
+    std::vector<Graph::Vertex> neighbors;
+
+    BipartiteGraphCSR(const Graph &graph, const std::vector<Group> &group_status) {
+      offsets.push_back(0);
+      for (Graph::Vertex vertex = 1; vertex < graph.GetVertexCount() + 1; ++vertex) {
+        if (group_status[vertex] != FIRST) {
+          continue;
         }
+        left_vertices.push_back(vertex);
+        for (auto neighbor : graph.GetAllNeighbors(vertex)) {
+          neighbors.push_back(neighbor);
+        }
+        offsets.push_back(neighbors.size());
       }
     }
-    return true;
+
+    size_t GetLeftCount() const {
+      return left_vertices.size();
+    }
+  };
+
+  /* Hopcroft-Karp: each phase finds a maximal set of vertex-disjoint shortest augmenting paths with one BFS
+   from all free left vertices and iterative DFS over the layers, so O(sqrt(V)) phases are enough.
+   Returns the mate of every vertex (0 if unmatched), or an empty vector if the graph is not bipartite. */
+  std::vector<Graph::Vertex> GetMaxMatching_HopcroftKarp(const Graph &graph) {
+    const Graph::Vertex NOT_MATCHED = 0;
+    const size_t NOT_REACHED = std::numeric_limits<size_t>::max();
+    std::vector<Group> group_status;
+    if (!GetBipartition(graph, group_status)) {
+      return {};
+    }
+    BipartiteGraphCSR csr(graph, group_status);
+    const size_t left_count = csr.GetLeftCount();
+    std::vector<Graph::Vertex> left_mate(left_count, NOT_MATCHED);
+    std::vector<size_t> right_mate(graph.GetVertexCount() + 1, NOT_REACHED);
+    std::vector<size_t> layer(left_count);
+    std::vector<size_t> current_arc(left_count);
+    std::vector<size_t> queue, stack;
+
+    while (true) {
+      queue.clear();
+      for (size_t left = 0; left < left_count; ++left) {
+        layer[left] = (left_mate[left] == NOT_MATCHED) ? 0 : NOT_REACHED;
+        if (layer[left] == 0) {
+          queue.push_back(left);
+        }
+      }
+      bool has_augmenting_path = false;
+      for (size_t head = 0; head < queue.size(); ++head) {
+        size_t left = queue[head];
+        for (size_t arc = csr.offsets[left]; arc < csr.offsets[left + 1]; ++arc) {
+          size_t next_left = right_mate[csr.neighbors[arc]];
+          if (next_left == NOT_REACHED) {
+            has_augmenting_path = true;
+          } else if (layer[next_left] == NOT_REACHED && !has_augmenting_path) {
+            layer[next_left] = layer[left] + 1;
+            queue.push_back(next_left);
+          }
+        }
+      }
+      if (!has_augmenting_path) {
+        break;
+      }
+
+      for (size_t left = 0; left < left_count; ++left) {
+        current_arc[left] = csr.offsets[left];
+      }
+      for (size_t root = 0; root < left_count; ++root) {
+        if (left_mate[root] != NOT_MATCHED || layer[root] != 0) {
+          continue;
+        }
+        stack.assign(1, root);
+        while (!stack.empty()) {
+          size_t left = stack.back();
+          if (current_arc[left] == csr.offsets[left + 1]) {
+            layer[left] = NOT_REACHED;
+            stack.pop_back();
+            if (!stack.empty()) {
+              ++current_arc[stack.back()];
+            }
+            continue;
+          }
+          size_t next_left = right_mate[csr.neighbors[current_arc[left]]];
+          if (next_left == NOT_REACHED) {
+            for (size_t path_left : stack) {
+              Graph::Vertex right = csr.neighbors[current_arc[path_left]];
+              left_mate[path_left] = right;
+              right_mate[right] = path_left;
+            }
+            stack.clear();
+          } else if (layer[next_left] != NOT_REACHED && layer[next_left] == layer[left] + 1) {
+            stack.push_back(next_left);
+          } else {
+            ++current_arc[left];
+          }
+        }
+      }
+    }
+
+    std::vector<Graph::Vertex> mate(graph.GetVertexCount() + 1, NOT_MATCHED);
+    for (size_t left = 0; left < left_count; ++left) {
+      if (left_mate[left] != NOT_MATCHED) {
+        mate[csr.left_vertices[left]] = left_mate[left];
+        mate[left_mate[left]] = csr.left_vertices[left];
+      }
+    }
+    return mate;
   }
 
 }
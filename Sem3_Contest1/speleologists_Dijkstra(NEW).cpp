@@ -159,23 +159,40 @@ namespace GraphProcessing {
 
   typedef std::priority_queue<Distance_Vertex, std::vector<Distance_Vertex>, std::greater<Distance_Vertex>> PriorityQueue;
 
-  void Relax(const Graph &graph, std::vector<size_t> &min_distance, const Graph::Vertex &neighbor,
+  const size_t INF = std::numeric_limits<size_t>::max();
+  const Graph::Vertex NOT_SET = std::numeric_limits<Graph::Vertex>::max();
+
+  // Shortest path forest grown from all starts at once: each vertex is labeled with its closest start.
+  struct ShortestPathForest {
+    std::vector<size_t> min_distance;
+    std::vector<Graph::Vertex> nearest_source;
+    std::vector<Graph::Edge> parent_edge;
+
+    explicit ShortestPathForest(size_t vertex_count)
+        : min_distance(vertex_count, INF),
+          nearest_source(vertex_count, NOT_SET),
+          parent_edge(vertex_count, {NOT_SET, NOT_SET}) {}
+  };
+
+  void Relax(const Graph &graph, ShortestPathForest &forest, const Graph::Vertex &neighbor,
              const Graph::Vertex &vertex, PriorityQueue &priority_queue) {
     size_t weight = graph.GetWeight(vertex, neighbor);
-    if (min_distance[neighbor] > weight + min_distance[vertex]) {
-      min_distance[neighbor] = weight + min_distance[vertex];
-      priority_queue.push({min_distance[neighbor], neighbor});
+    if (forest.min_distance[neighbor] > weight + forest.min_distance[vertex]) {
+      forest.min_distance[neighbor] = weight + forest.min_distance[vertex];
+      forest.nearest_source[neighbor] = forest.nearest_source[vertex];
+      forest.parent_edge[neighbor] = {vertex, neighbor};
+      priority_queue.push({forest.min_distance[neighbor], neighbor});
     }
   }
 
-  std::vector<size_t> GetMinDistances_Dijkstra(const Graph &graph, const std::vector<Graph::Vertex> &starts) {
-    const size_t INF = std::numeric_limits<size_t>::max();
+  ShortestPathForest GetShortestPathForest_Dijkstra(const Graph &graph, const std::vector<Graph::Vertex> &starts) {
     const size_t vertex_count = graph.GetVertexCount();
-    std::vector<size_t> min_distance(vertex_count + 1, INF);
+    ShortestPathForest forest(vertex_count + 1);
     std::vector<bool> visited(vertex_count + 1, false);
     PriorityQueue priority_queue;
     for (auto start : starts) {
-      min_distance[start] = 0;
+      forest.min_distance[start] = 0;
+      forest.nearest_source[start] = start;
       priority_queue.push({0, start});
     }
     while (!priority_queue.empty()) {
@@ -186,10 +203,14 @@ namespace GraphProcessing {
       }
       visited[vertex] = true;
       for (const auto &neighbor : graph.GetAllNeighbors(vertex)) {
-        Relax(graph, min_distance, neighbor, vertex, priority_queue);
+        Relax(graph, forest, neighbor, vertex, priority_queue);
       }
     }
-    return min_distance;
+    return forest;
+  }
+
+  std::vector<size_t> GetMinDistances_Dijkstra(const Graph &graph, const std::vector<Graph::Vertex> &starts) {
+    return GetShortestPathForest_Dijkstra(graph, starts).min_distance;
   }
 }
 
@@ -38,54 +38,192 @@ Input	    Output
 #include <iostream>
 #include <vector>
 #include <algorithm>
+#include <cstring>
+#include <cstdint>
+#include <type_traits>
+#include <functional>
 
-unsigned int a, b;
-unsigned int cur = 0;
-unsigned int nextRand() {
-  cur = cur * a + b;
-  return cur >> 8u;
+// values[i] = operation(...operation(operation(carry, values[0]), values[1])..., values[i]), returns the last one.
+template<typename T, typename Operation>
+T SequentialScan(T *values, size_t size, T carry, const Operation &operation) {
+  for (size_t i = 0; i < size; ++i) {
+    carry = operation(carry, values[i]);
+    values[i] = carry;
+  }
+  return carry;
+}
+
+/* Sums of 32-bit integers are scanned 4 at a time with GCC vector extensions: two shifted adds give the sums inside
+ the vector, then the carry of the previous vector is added to all lanes. */
+template<typename T, typename std::enable_if<std::is_integral<T>::value && sizeof(T) == 4>::type * = nullptr>
+T SequentialScan(T *values, size_t size, T carry, const std::plus<T> &) {
+  typedef T Vector __attribute__((vector_size(16)));
+  typedef uint32_t Mask __attribute__((vector_size(16)));
+  static constexpr size_t kLanes = sizeof(Vector) / sizeof(T);
+  const Vector zero = {0, 0, 0, 0};
+  Vector carries = {carry, carry, carry, carry};
+  size_t i = 0;
+  for (; i + kLanes <= size; i += kLanes) {
+    Vector sums;
+    std::memcpy(&sums, values + i, sizeof(Vector));
+    sums += __builtin_shuffle(sums, zero, Mask{4, 0, 1, 2});
+    sums += __builtin_shuffle(sums, zero, Mask{4, 5, 0, 1});
+    sums += carries;
+    std::memcpy(values + i, &sums, sizeof(Vector));
+    carries = __builtin_shuffle(sums, Mask{3, 3, 3, 3});
+  }
+  carry = carries[0];
+  for (; i < size; ++i) {
+    carry += values[i];
+    values[i] = carry;
+  }
+  return carry;
 }
 
+/* In-place inclusive scan for any associative operation, no identity needed. Single-threaded: ScanBenchmark.cpp
+ compares it with a reduce-then-scan split between threads. */
+template<typename T, typename Operation>
+void InclusiveScan(T *values, size_t size, const Operation &operation) {
+  if (size == 0) {
+    return;
+  }
+  SequentialScan(values + 1, size - 1, values[0], operation);
+}
+
+/* Offline range add / range sum: adds go to a difference array, Build turns it into prefix sums of the values with two
+ scans, after which sums are answered in O(1). The extra last cell takes the right + 1 == size write. */
+template<typename T>
+class DifferenceArray {
+ private:
+  size_t size_;
+  std::vector<T> values_;
+
+ public:
+  explicit DifferenceArray(size_t size) : size_(size), values_(size + 1, T(0)) {}
+
+  void Add(size_t left, size_t right, const T &value) {
+    values_[left] += value;
+    values_[right + 1] -= value;
+  }
+
+  void Build() {
+    InclusiveScan(values_.data(), size_, std::plus<T>());
+    InclusiveScan(values_.data(), size_, std::plus<T>());
+  }
+
+  T RangeSum(size_t left, size_t right) const {
+    return (left == 0) ? values_[right] : values_[right] - values_[left - 1];
+  }
+};
+
+/* The same for rectangles of a height x width grid, stored row by row with an extra row and column. One 2D prefix
+ pass scans every row, then adds each row to the next one column by column. */
+template<typename T>
+class DifferenceArray2D {
+ private:
+  size_t height_;
+  size_t width_;
+  std::vector<T> values_;
+
+  T *Row(size_t row) {
+    return values_.data() + row * (width_ + 1);
+  }
+
+  T PrefixSum(size_t bottom, size_t right) const {
+    return values_[bottom * (width_ + 1) + right];
+  }
+
+  void PrefixSums2D() {
+    for (size_t row = 0; row < height_; ++row) {
+      SequentialScan(Row(row), width_, T(0), std::plus<T>());
+    }
+    for (size_t row = 1; row < height_; ++row) {
+      const T *previous_row = Row(row - 1);
+      T *current_row = Row(row);
+      for (size_t column = 0; column < width_; ++column) {
+        current_row[column] += previous_row[column];
+      }
+    }
+  }
+
+ public:
+  DifferenceArray2D(size_t height, size_t width)
+      : height_(height), width_(width), values_((height + 1) * (width + 1), T(0)) {}
+
+  void Add(size_t top, size_t left, size_t bottom, size_t right, const T &value) {
+    Row(top)[left] += value;
+    Row(top)[right + 1] -= value;
+    Row(bottom + 1)[left] -= value;
+    Row(bottom + 1)[right + 1] += value;
+  }
+
+  void Build() {
+    PrefixSums2D();
+    PrefixSums2D();
+  }
+
+  T RangeSum(size_t top, size_t left, size_t bottom, size_t right) const {
+    T sum = PrefixSum(bottom, right);
+    if (top > 0) {
+      sum -= PrefixSum(top - 1, right);
+    }
+    if (left > 0) {
+      sum -= PrefixSum(bottom, left - 1);
+    }
+    if (top > 0 && left > 0) {
+      sum += PrefixSum(top - 1, left - 1);
+    }
+    return sum;
+  }
+};
+
+// nextRand of the statement as an object.
+class RandomGenerator {
+ private:
+  unsigned int a_;
+  unsigned int b_;
+  unsigned int cur_;
+
+ public:
+  RandomGenerator(unsigned int a, unsigned int b) : a_(a), b_(b), cur_(0) {}
+
+  unsigned int Next() {
+    cur_ = cur_ * a_ + b_;
+    return cur_ >> 8u;
+  }
+};
+
 int main() {
   size_t values_num, quires_num;
+  unsigned int a, b;
   constexpr size_t base_2_power_24 = 1u << 24u;
   std::ios_base::sync_with_stdio(false);
   std::cin.tie(nullptr);
   std::cout.tie(nullptr);
   std::cin >> values_num >> quires_num >> a >> b;
-  std::vector<unsigned int> values(base_2_power_24, 0);
-  std::vector<unsigned int> sum_segment(base_2_power_24, 0);
-  unsigned int l, r, add;
+  RandomGenerator generator(a, b);
+  // Queries are generated while they are processed and never stored.
+  DifferenceArray<unsigned int> values(base_2_power_24);
   for (size_t i = 0; i < values_num; ++i) {
-    add = nextRand();
-    l = nextRand();
-    r = nextRand();
+    const unsigned int add = generator.Next();
+    unsigned int l = generator.Next();
+    unsigned int r = generator.Next();
     if (l > r) {
       std::swap(l, r);
     }
-    values[l] += add;
-    values[r + 1] -= add;
-  }
-  sum_segment[0] = values[0];
-  unsigned int current_sum = values[0];
-  for (size_t i = 1; i < base_2_power_24; ++i) {
-    current_sum += values[i];
-    sum_segment[i] = current_sum + sum_segment[i - 1];
+    values.Add(l, r, add);
   }
-  unsigned int rsq = 0;
+  values.Build();
+  unsigned int total_rsq = 0;
   for (size_t i = 0; i < quires_num; ++i) {
-    l = nextRand();
-    r = nextRand();
+    unsigned int l = generator.Next();
+    unsigned int r = generator.Next();
     if (l > r) {
       std::swap(l, r);
     }
-    if (l == 0) {
-      rsq += sum_segment[r];
-    } else {
-      rsq += sum_segment[r] - sum_segment[l - 1];
-    }
+    total_rsq += values.RangeSum(l, r);
   }
-  std::cout << rsq;
+  std::cout << total_rsq;
 
   return 0;
-}
\ No newline at end of file
+}
@@ -30,7 +30,6 @@ Input	        Output
 #include <iostream>
 #include <vector>
 #include <algorithm>
-#include <memory>
 #include <limits>
 #include <string>
 
@@ -39,149 +38,223 @@ enum Bracket {
   CLOSE_BRACKET = ')'
 };
 
-////////////////////////////// class SegmentTree (Declaration) //////////////////////////////
+////////////////////////////// Monoids //////////////////////////////
 
-template<typename T>
-class SegmentTree {
- private:
-  struct Node {
+struct BalancedSequence {
+  struct Type {
     size_t free_left_brackets_num_;
     size_t free_right_brackets_num_;
     size_t max_length_;
-    static constexpr size_t pending_value_ = 0;
+  };
 
-    Node();
+  static Type Identity() {
+    return {0, 0, 0};
+  }
 
-    Node(const Node &first, const Node &second);
+  static Type Combine(const Type &lhs, const Type &rhs) {
+    size_t delta = std::min(lhs.free_left_brackets_num_, rhs.free_right_brackets_num_);
+    return {lhs.free_left_brackets_num_ + rhs.free_left_brackets_num_ - delta,
+            lhs.free_right_brackets_num_ + rhs.free_right_brackets_num_ - delta,
+            lhs.max_length_ + rhs.max_length_ + 2 * delta};
+  }
 
-    Node &operator=(const char &value);
-  };
+  static Type FromBracket(char bracket) {
+    return (bracket == OPEN_BRACKET) ? Type{1, 0, 0} : Type{0, 1, 0};
+  }
+};
+
+struct NoAction {
+  typedef bool Type;
+
+  static Type Identity() {
+    return false;
+  }
+
+  static Type Compose(const Type &, const Type &) {
+    return false;
+  }
+
+  template<typename Value>
+  static Value Apply(const Type &, const Value &value, size_t) {
+    return value;
+  }
+};
+
+////////////////////////////// class SegmentTree (Declaration) //////////////////////////////
 
-  std::vector<Node> segment_tree_;
+/* Bottom-up segment tree with lazy propagation.
+ ValueMonoid:  Type, Identity(), Combine(lhs, rhs) - associative, not necessarily commutative.
+ ActionMonoid: Type, Identity(), Compose(outer, inner) - action "outer after inner",
+               Apply(action, value, length) - result of the action on a segment of length elements. */
+template<typename ValueMonoid, typename ActionMonoid = NoAction>
+class SegmentTree {
+ public:
+  typedef typename ValueMonoid::Type Value;
+  typedef typename ActionMonoid::Type Action;
+
+ private:
+  size_t size_;
+  size_t height_;
+  std::vector<Value> segment_tree_;
+  std::vector<Action> pending_;
 
   static size_t Log_2(size_t value);
   static size_t PowerOfTwo_Ceil(size_t value);
 
-  T Parent(size_t idx) const {
+  size_t Parent(size_t idx) const {
     return idx / 2;
   }
 
-  T LeftChild(size_t idx) const {
+  size_t LeftChild(size_t idx) const {
     return idx * 2;
   }
 
-  T RightChild(size_t idx) const {
+  size_t RightChild(size_t idx) const {
     return idx * 2 + 1;
   }
 
-  struct MakeBalancedSequence_ {
-    Node operator()(const Node &lhs, const Node &rhs) const;
-  };
-
-  template<typename BinaryOperation>
-  Node Query(size_t left, size_t right, const BinaryOperation &binary_operation) const;
+  void ApplyToNode(size_t idx, const Action &action, size_t length);
+  void PushToChildren(size_t idx, size_t length);
+  void PushPath(size_t left, size_t right);
+  void UpdateNode(size_t idx);
 
  public:
-  explicit SegmentTree(const std::string &input);
+  explicit SegmentTree(const std::vector<Value> &values);
+
+  void Set(size_t idx, const Value &value);
+
+  Value Get(size_t idx);
 
-  size_t BalancedSequenceMaxLength(size_t left, size_t right) const;
+  void Update(size_t left, size_t right, const Action &action);
+
+  Value Query(size_t left, size_t right);
 };
 
 ////////////////////////////// class SegmentTree (Implementation) //////////////////////////////
 
-template<typename T>
-SegmentTree<T>::Node::Node() {
-  free_left_brackets_num_ = pending_value_;
-  free_right_brackets_num_ = pending_value_;
-  max_length_ = pending_value_;
+template<typename ValueMonoid, typename ActionMonoid>
+size_t SegmentTree<ValueMonoid, ActionMonoid>::Log_2(size_t value) {
+  size_t result = 0;
+  while (value >>= 1u) {
+    ++result;
+  }
+  return result;
 }
 
-template<typename T>
-SegmentTree<T>::Node::Node(const Node &first, const Node &second) {
-  Node node = MakeBalancedSequence_()(first, second);
-  free_left_brackets_num_ = node.free_left_brackets_num_;
-  free_right_brackets_num_ = node.free_right_brackets_num_;
-  max_length_ = node.max_length_;
+template<typename ValueMonoid, typename ActionMonoid>
+size_t SegmentTree<ValueMonoid, ActionMonoid>::PowerOfTwo_Ceil(size_t value) {
+  return (value <= 1) ? 1 : size_t(1) << (Log_2(value - 1) + 1);
 }
 
-template<typename T>
-typename SegmentTree<T>::Node &SegmentTree<T>::Node::operator=(const char &value) {
-  if (value == OPEN_BRACKET) {
-    free_left_brackets_num_ = 1;
-    free_right_brackets_num_ = 0;
-  } else {
-    free_right_brackets_num_ = 1;
-    free_left_brackets_num_ = 0;
-  }
-  max_length_ = 0;
-  return *this;
+template<typename ValueMonoid, typename ActionMonoid>
+SegmentTree<ValueMonoid, ActionMonoid>::SegmentTree(const std::vector<Value> &values)
+    : size_(values.size()),
+      height_(Log_2(PowerOfTwo_Ceil(values.size()))),
+      segment_tree_(2 * PowerOfTwo_Ceil(values.size()), ValueMonoid::Identity()),
+      pending_(PowerOfTwo_Ceil(values.size()), ActionMonoid::Identity()) {
+  const size_t half_tree_size = segment_tree_.size() / 2;
+  for (size_t idx = 0; idx < size_; ++idx) {
+    segment_tree_[idx + half_tree_size] = values[idx];
+  }
+  for (size_t idx = half_tree_size - 1; idx > 0; --idx) {
+    UpdateNode(idx);
+  }
 }
 
-template<typename T>
-template<typename BinaryOperation>
-typename SegmentTree<T>::Node SegmentTree<T>::Query(size_t left, size_t right,
-                                                    const BinaryOperation &binary_operation) const {
-  Node left_answer;
-  Node right_answer;
-  const size_t tree_size = segment_tree_.size();
-  left += tree_size / 2;
-  right += tree_size / 2;
-  while (left <= right) {
-    if (left == RightChild(Parent(left))) {
-      left_answer = binary_operation(left_answer, segment_tree_[left]);
+template<typename ValueMonoid, typename ActionMonoid>
+void SegmentTree<ValueMonoid, ActionMonoid>::ApplyToNode(size_t idx, const Action &action, size_t length) {
+  segment_tree_[idx] = ActionMonoid::Apply(action, segment_tree_[idx], length);
+  if (idx < pending_.size()) {
+    pending_[idx] = ActionMonoid::Compose(action, pending_[idx]);
+  }
+}
+
+template<typename ValueMonoid, typename ActionMonoid>
+void SegmentTree<ValueMonoid, ActionMonoid>::PushToChildren(size_t idx, size_t length) {
+  ApplyToNode(LeftChild(idx), pending_[idx], length / 2);
+  ApplyToNode(RightChild(idx), pending_[idx], length / 2);
+  pending_[idx] = ActionMonoid::Identity();
+}
+
+// Pushes pending actions down to the borders of the half-open leaf range [left, right).
+template<typename ValueMonoid, typename ActionMonoid>
+void SegmentTree<ValueMonoid, ActionMonoid>::PushPath(size_t left, size_t right) {
+  for (size_t level = height_; level > 0; --level) {
+    if (((left >> level) << level) != left) {
+      PushToChildren(left >> level, size_t(1) << level);
     }
-    if (right == LeftChild(Parent(right))) {
-      right_answer = binary_operation(segment_tree_[right], right_answer);
+    if (((right >> level) << level) != right) {
+      PushToChildren((right - 1) >> level, size_t(1) << level);
     }
-    left = Parent(left + 1);
-    right = Parent(right - 1);
   }
-  return binary_operation(left_answer, right_answer);
 }
 
-template<typename T>
-size_t SegmentTree<T>::Log_2(size_t value) {
-  size_t result = 0;
-  while (value >>= 1u) {
-    ++result;
-  }
-  return result;
+template<typename ValueMonoid, typename ActionMonoid>
+void SegmentTree<ValueMonoid, ActionMonoid>::UpdateNode(size_t idx) {
+  segment_tree_[idx] = ValueMonoid::Combine(segment_tree_[LeftChild(idx)], segment_tree_[RightChild(idx)]);
 }
 
-template<typename T>
-size_t SegmentTree<T>::PowerOfTwo_Ceil(size_t value) {
-  return 1u << (Log_2(value - 1) + 1);
+template<typename ValueMonoid, typename ActionMonoid>
+void SegmentTree<ValueMonoid, ActionMonoid>::Set(size_t idx, const Value &value) {
+  idx += segment_tree_.size() / 2;
+  PushPath(idx, idx + 1);
+  segment_tree_[idx] = value;
+  while ((idx = Parent(idx)) > 0) {
+    UpdateNode(idx);
+  }
 }
 
-template<typename T>
-typename SegmentTree<T>::Node SegmentTree<T>::MakeBalancedSequence_::operator()(const Node &lhs, const Node &rhs) const {
-  Node node;
-  size_t delta = std::min(lhs.free_left_brackets_num_, rhs.free_right_brackets_num_);
-  node.max_length_ = lhs.max_length_ + rhs.max_length_ + 2 * delta;
-  node.free_left_brackets_num_ = lhs.free_left_brackets_num_ + rhs.free_left_brackets_num_ - delta;
-  node.free_right_brackets_num_ = lhs.free_right_brackets_num_ + rhs.free_right_brackets_num_ - delta;
-  return node;
+template<typename ValueMonoid, typename ActionMonoid>
+typename SegmentTree<ValueMonoid, ActionMonoid>::Value SegmentTree<ValueMonoid, ActionMonoid>::Get(size_t idx) {
+  idx += segment_tree_.size() / 2;
+  PushPath(idx, idx + 1);
+  return segment_tree_[idx];
 }
 
-template<typename T>
-SegmentTree<T>::SegmentTree(const std::string &input)
-    : segment_tree_(2 * PowerOfTwo_Ceil(input.size())) {
+template<typename ValueMonoid, typename ActionMonoid>
+void SegmentTree<ValueMonoid, ActionMonoid>::Update(size_t left, size_t right, const Action &action) {
   const size_t half_tree_size = segment_tree_.size() / 2;
-  const size_t values_size = input.size();
-  for (size_t idx = values_size; idx < PowerOfTwo_Ceil(input.size()); ++idx) {
-    segment_tree_[idx + half_tree_size] = Node();
-  }
-  for (size_t idx = 0; idx < values_size; ++idx) {
-    segment_tree_[idx + half_tree_size] = input[idx];
+  left += half_tree_size;
+  right += half_tree_size + 1;
+  PushPath(left, right);
+  for (size_t lhs = left, rhs = right, length = 1; lhs < rhs; lhs = Parent(lhs), rhs = Parent(rhs), length *= 2) {
+    if (lhs & 1u) {
+      ApplyToNode(lhs++, action, length);
+    }
+    if (rhs & 1u) {
+      ApplyToNode(--rhs, action, length);
+    }
   }
-  for (size_t idx = half_tree_size - 1; idx > 0; --idx) {
-    segment_tree_[idx] = Node(segment_tree_[LeftChild(idx)], segment_tree_[RightChild(idx)]);
+  for (size_t level = 1; level <= height_; ++level) {
+    if (((left >> level) << level) != left) {
+      UpdateNode(left >> level);
+    }
+    if (((right >> level) << level) != right) {
+      UpdateNode((right - 1) >> level);
+    }
   }
 }
 
-template<typename T>
-size_t SegmentTree<T>::BalancedSequenceMaxLength(size_t left, size_t right) const {
-  return Query(left, right, MakeBalancedSequence_()).max_length_;
+template<typename ValueMonoid, typename ActionMonoid>
+typename SegmentTree<ValueMonoid, ActionMonoid>::Value SegmentTree<ValueMonoid, ActionMonoid>::Query(size_t left,
+                                                                                                     size_t right) {
+  const size_t half_tree_size = segment_tree_.size() / 2;
+  left += half_tree_size;
+  right += half_tree_size + 1;
+  PushPath(left, right);
+  Value left_answer = ValueMonoid::Identity();
+  Value right_answer = ValueMonoid::Identity();
+  while (left < right) {
+    if (left & 1u) {
+      left_answer = ValueMonoid::Combine(left_answer, segment_tree_[left++]);
+    }
+    if (right & 1u) {
+      right_answer = ValueMonoid::Combine(segment_tree_[--right], right_answer);
+    }
+    left = Parent(left);
+    right = Parent(right);
+  }
+  return ValueMonoid::Combine(left_answer, right_answer);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -192,13 +265,17 @@ int main() {
   std::cout.tie(nullptr);
   std::string sequence;
   std::cin >> sequence;
-  SegmentTree<int64_t> segment_tree(sequence);
+  std::vector<BalancedSequence::Type> brackets(sequence.size());
+  for (size_t i = 0; i < sequence.size(); ++i) {
+    brackets[i] = BalancedSequence::FromBracket(sequence[i]);
+  }
+  SegmentTree<BalancedSequence> segment_tree(brackets);
   size_t query_num;
   std::cin >> query_num;
   for (size_t i = 0; i < query_num; ++i) {
     size_t left, right;
     std::cin >> left >> right;
-    std::cout << segment_tree.BalancedSequenceMaxLength(left - 1, right - 1) << std::endl;
+    std::cout << segment_tree.Query(left - 1, right - 1).max_length_ << std::endl;
   }
 
   return 0;
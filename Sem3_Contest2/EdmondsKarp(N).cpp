@@ -64,12 +64,16 @@ class FlowNetwork {
   size_t edge_count_;
   Vertex source_, termination_;
   std::vector<FlowEdgePair> predecessors_;
-  bool HasIncreasingPath();
+  Flow max_flow_;
+  bool HasIncreasingPath(const Vertex &start, const Vertex &finish);
+  Flow PushFlow(const Vertex &start, const Vertex &finish, const Flow &flow_limit);
  public:
 
   FlowNetwork::Flow GetMaxFlow_EdmondsKarp();
   FlowNetwork(size_t vertex_count, size_t edges_count, const Vertex &source, const Vertex &termination);
   void AddEdge(const Vertex &from, const Vertex &to, const Flow &capacity, size_t index);
+  size_t AddEdge(const Vertex &from, const Vertex &to, const Flow &capacity);
+  void UpdateCapacity(size_t index, const Flow &capacity);
   Vertex GetSource() const;
   Vertex GetTermination() const;
   size_t GetVertexCount() const;
@@ -88,7 +92,8 @@ FlowNetwork::FlowNetwork(size_t vertex_count, size_t edges_count, const Vertex &
       index_edge_(2 * edges_count),
       visited_(vertex_count, false),
       predecessors_(vertex_count),
-      termination_(termination) {}
+      termination_(termination),
+      max_flow_(0) {}
 
 void FlowNetwork::AddEdge(const Vertex &from, const Vertex &to, const Flow &capacity, size_t index) {
   index_edge_[2 * index] = FlowEdge(from, to, capacity);
@@ -97,6 +102,44 @@ void FlowNetwork::AddEdge(const Vertex &from, const Vertex &to, const Flow &capa
   adj_list_[to].push_back(2 * index + 1);
 }
 
+// Appends an edge to an already built (possibly solved) network and returns its index.
+size_t FlowNetwork::AddEdge(const Vertex &from, const Vertex &to, const Flow &capacity) {
+  size_t index = edge_count_++;
+  index_edge_.resize(2 * edge_count_);
+  AddEdge(from, to, capacity, index);
+  return index;
+}
+
+/* Keeps the current flow feasible after the capacity change. If the edge now carries too much flow,
+ the excess is first rerouted around the edge, and only what can not be rerouted is cancelled back to
+ the source and the termination. Call GetMaxFlow_EdmondsKarp() afterwards to restore maximality. */
+void FlowNetwork::UpdateCapacity(size_t index, const Flow &capacity) {
+  FlowEdge &flow_edge = index_edge_[2 * index];
+  flow_edge.capacity = capacity;
+  if (flow_edge.flow <= capacity) {
+    return;
+  }
+  const Flow excess = flow_edge.flow - capacity;
+  const Vertex from = flow_edge.from;
+  const Vertex to = flow_edge.to;
+  flow_edge.flow = capacity;
+  GetBackEdge(2 * index).flow = -capacity;
+  const Flow cancelled_flow = excess - PushFlow(from, to, excess);
+  if (cancelled_flow == 0) {
+    return;
+  }
+  if (from != termination_) {
+    PushFlow(from, source_, cancelled_flow);
+  }
+  if (to != source_) {
+    PushFlow(termination_, to, cancelled_flow);
+  }
+  max_flow_ = 0;
+  for (size_t source_edge_index : adj_list_[source_]) {
+    max_flow_ += index_edge_[source_edge_index].flow;
+  }
+}
+
 std::vector<size_t> FlowNetwork::GetEdgesIndicesIncidentOn(const FlowNetwork::Vertex &vertex) const {
   return adj_list_[vertex];
 }
@@ -136,32 +179,39 @@ FlowNetwork::Vertex FlowNetwork::FlowEdge::Other(const FlowNetwork::Vertex &vert
 
 ////////////////////////////// EdmondsKarpAlgorithm //////////////////////////////
 
+// Continues from the current flow, so after small edits of a solved network only a few paths are found.
 FlowNetwork::Flow FlowNetwork::GetMaxFlow_EdmondsKarp() {
   const Flow INF = std::numeric_limits<Flow>::max();
-  const auto NOT_SET = new FlowEdge(0, 0, 0);
-  predecessors_.assign(vertex_count_, {NOT_SET, NOT_SET});
-  Flow max_flow = 0;
-  while (HasIncreasingPath()) {
-    Flow blocking_flow = INF;
-    for (Vertex vertex = termination_; vertex != source_; vertex = predecessors_[vertex].forward_edge->Other(vertex)) {
+  max_flow_ += PushFlow(source_, termination_, INF);
+  return max_flow_;
+}
+
+FlowNetwork::Flow FlowNetwork::PushFlow(const Vertex &start, const Vertex &finish, const Flow &flow_limit) {
+  if (start == finish) {
+    return flow_limit;
+  }
+  predecessors_.assign(vertex_count_, {nullptr, nullptr});
+  Flow pushed_flow = 0;
+  while (pushed_flow < flow_limit && HasIncreasingPath(start, finish)) {
+    Flow blocking_flow = flow_limit - pushed_flow;
+    for (Vertex vertex = finish; vertex != start; vertex = predecessors_[vertex].forward_edge->Other(vertex)) {
       blocking_flow = std::min(blocking_flow, predecessors_[vertex].forward_edge->ResidualCapacity());
     }
-    for (Vertex vertex = termination_; vertex != source_; vertex = predecessors_[vertex].forward_edge->Other(vertex)) {
+    for (Vertex vertex = finish; vertex != start; vertex = predecessors_[vertex].forward_edge->Other(vertex)) {
       predecessors_[vertex].forward_edge->flow += blocking_flow;
       predecessors_[vertex].back_edge->flow -= blocking_flow;
     }
-    predecessors_.assign(vertex_count_, {NOT_SET, NOT_SET});
-    max_flow += blocking_flow;
+    pushed_flow += blocking_flow;
   }
-  return max_flow;
+  return pushed_flow;
 }
 
-bool FlowNetwork::HasIncreasingPath() {
+bool FlowNetwork::HasIncreasingPath(const Vertex &start, const Vertex &finish) {
   visited_.assign(vertex_count_, false);
   std::queue<Vertex> queue;
-  queue.push(source_);
-  visited_[source_] = true;
-  while (!queue.empty() && !visited_[termination_]) {
+  queue.push(start);
+  visited_[start] = true;
+  while (!queue.empty() && !visited_[finish]) {
     Vertex vertex = queue.front();
     queue.pop();
     for (size_t index : adj_list_[vertex]) {
@@ -176,7 +226,7 @@ bool FlowNetwork::HasIncreasingPath() {
       }
     }
   }
-  return visited_[termination_];
+  return visited_[finish];
 }
 
 ////////////////////////////////////////////////////////////////////////////////
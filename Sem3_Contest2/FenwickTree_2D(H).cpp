@@ -30,6 +30,11 @@ Input	     Output
 
 #include <iostream>
 #include <vector>
+#include <array>
+#include <algorithm>
+#include <utility>
+#include <unordered_map>
+#include <cstdint>
 
 struct Point {
   int64_t x_;
@@ -38,36 +43,454 @@ struct Point {
   Point(int64_t x, int64_t y) : x_(x), y_(y) {}
 };
 
+// Sorts rectangles by key(rectangle) < key_limit with a counting sort and pairs each with its input index.
+template<typename Query, typename Key>
+std::vector<std::pair<Query, size_t>> SortQueries(const std::vector<Query> &queries, size_t key_limit, const Key &key) {
+  const size_t buckets_count = queries.size() + 1;
+  std::vector<size_t> bucket(queries.size());
+  std::vector<size_t> bucket_begin(buckets_count + 1, 0);
+  for (size_t idx = 0; idx < queries.size(); ++idx) {
+    bucket[idx] = key(queries[idx]) * buckets_count / std::max<size_t>(1, key_limit);
+    ++bucket_begin[bucket[idx] + 1];
+  }
+  for (size_t idx = 0; idx < buckets_count; ++idx) {
+    bucket_begin[idx + 1] += bucket_begin[idx];
+  }
+  std::vector<size_t> order(queries.size());
+  for (size_t idx = 0; idx < queries.size(); ++idx) {
+    order[bucket_begin[bucket[idx]]++] = idx;
+  }
+  std::vector<std::pair<Query, size_t>> sorted;
+  sorted.reserve(queries.size());
+  for (size_t idx : order) {
+    sorted.emplace_back(queries[idx], idx);
+  }
+  return sorted;
+}
+
+// Fills answers[position] in sorted order; the rectangle kPrefetchDistance steps ahead is prefetched meanwhile.
+template<typename Query, typename Answer, typename AnswerQuery, typename Prefetch>
+void AnswerSortedQueries(const std::vector<std::pair<Query, size_t>> &sorted, std::vector<Answer> &answers,
+                         const AnswerQuery &answer_query, const Prefetch &prefetch) {
+  static constexpr size_t kPrefetchDistance = 8;
+  for (size_t idx = 0; idx < sorted.size(); ++idx) {
+    if (idx + kPrefetchDistance < sorted.size()) {
+      prefetch(sorted[idx + kPrefetchDistance].first);
+    }
+    answers[sorted[idx].second] = answer_query(sorted[idx].first);
+  }
+}
+
+////////// class FenwickTree (Declaration) //////////
+
+/* Index walks of an N-dimensional Fenwick tree stored in one flat array (last coordinate contiguous). The loop over
+ dimension kDimension calls the walk of the next dimension, the recursion is instantiated per dimension and unrolled
+ by the compiler; visit gets the flat index of every cell on the walk. */
+template<size_t kDimension, size_t kDimensions>
+struct FenwickWalk {
+  using Coordinates = std::array<int64_t, kDimensions>;
+  using Sizes = std::array<size_t, kDimensions>;
+
+  template<typename Visit>
+  static void Update(const Coordinates &point, const Sizes &sizes, const Sizes &strides, size_t offset,
+                     const Visit &visit) {
+    for (size_t i = point[kDimension]; i < sizes[kDimension]; i = (i | (i + 1))) {
+      FenwickWalk<kDimension + 1, kDimensions>::Update(point, sizes, strides, offset + i * strides[kDimension], visit);
+    }
+  }
+
+  template<typename Visit>
+  static void Prefix(const Coordinates &point, const Sizes &strides, size_t offset, const Visit &visit) {
+    for (int64_t i = point[kDimension]; i >= 0; i = ((i & (i + 1)) - 1)) {
+      FenwickWalk<kDimension + 1, kDimensions>::Prefix(point, strides, offset + i * strides[kDimension], visit);
+    }
+  }
+
+  // Walks rhs and lhs - 1 down together; the cells both prefixes share cancel out and are skipped.
+  template<typename Visit>
+  static void Range(const Coordinates &lhs, const Coordinates &rhs, const Sizes &strides, size_t offset,
+                    bool negative, const Visit &visit) {
+    int64_t i = rhs[kDimension];
+    int64_t j = lhs[kDimension] - 1;
+    while (i != j) {
+      if (i > j) {
+        FenwickWalk<kDimension + 1, kDimensions>::Range(lhs, rhs, strides, offset + i * strides[kDimension],
+                                                        negative, visit);
+        i = ((i & (i + 1)) - 1);
+      } else {
+        FenwickWalk<kDimension + 1, kDimensions>::Range(lhs, rhs, strides, offset + j * strides[kDimension],
+                                                        !negative, visit);
+        j = ((j & (j + 1)) - 1);
+      }
+    }
+  }
+};
+
+template<size_t kDimensions>
+struct FenwickWalk<kDimensions, kDimensions> {
+  using Coordinates = std::array<int64_t, kDimensions>;
+  using Sizes = std::array<size_t, kDimensions>;
+
+  template<typename Visit>
+  static void Update(const Coordinates &, const Sizes &, const Sizes &, size_t offset, const Visit &visit) {
+    visit(offset);
+  }
+
+  template<typename Visit>
+  static void Prefix(const Coordinates &, const Sizes &, size_t offset, const Visit &visit) {
+    visit(offset);
+  }
+
+  template<typename Visit>
+  static void Range(const Coordinates &, const Coordinates &, const Sizes &, size_t offset, bool negative,
+                    const Visit &visit) {
+    visit(offset, negative);
+  }
+};
+
+// Point update and box sum over a flat kDimensions-dimensional array; coordinates are 0-indexed, boxes inclusive.
+template<typename T, size_t kDimensions>
+class FenwickTree {
+ public:
+  using Coordinates = std::array<int64_t, kDimensions>;
+  using Sizes = std::array<size_t, kDimensions>;
+
+ private:
+  Sizes sizes_;
+  Sizes strides_;
+  std::vector<T> tree_;
+
+ public:
+  explicit FenwickTree(const Sizes &sizes);
+  void Update(const Coordinates &point, const T &value);
+  T RSQ(const Coordinates &lhs, const Coordinates &rhs) const;
+  void Prefetch(const Coordinates &point) const;
+  size_t GetSize(size_t dimension) const;
+};
+
+/* Range add and box sum with 2^kDimensions trees. An add on a box is 2^kDimensions signed point adds d(q) at its
+ corners, and the prefix sum up to x is the sum over q <= x of d(q) * prod_k (x_k + 1 - q_k). Expanding the product,
+ tree S stores d(q) * prod_{k in S} q_k; the trees are interleaved so one walk updates or reads all of them. */
+template<typename T, size_t kDimensions>
+class RangeFenwickTree {
+ public:
+  using Coordinates = std::array<int64_t, kDimensions>;
+  using Sizes = std::array<size_t, kDimensions>;
+
+ private:
+  static constexpr size_t kTreesCount = size_t(1) << kDimensions;
+
+  Sizes sizes_;
+  Sizes strides_;
+  std::vector<std::array<T, kTreesCount>> tree_;
+
+  void AddToCorner(const Coordinates &corner, const T &value);
+  T PrefixSum(const Coordinates &point) const;
+ public:
+  explicit RangeFenwickTree(const Sizes &sizes);
+  void Update(const Coordinates &lhs, const Coordinates &rhs, const T &value);
+  T RSQ(const Coordinates &lhs, const Coordinates &rhs) const;
+  size_t GetSize(size_t dimension) const;
+};
+
+////////// class FenwickTree (Definition) //////////
+
+template<typename T, size_t kDimensions>
+FenwickTree<T, kDimensions>::FenwickTree(const Sizes &sizes) : sizes_(sizes) {
+  size_t cells_count = 1;
+  for (size_t dimension = kDimensions; dimension-- > 0;) {
+    strides_[dimension] = cells_count;
+    cells_count *= sizes_[dimension];
+  }
+  tree_.assign(cells_count, T(0));
+}
+
+template<typename T, size_t kDimensions>
+void FenwickTree<T, kDimensions>::Update(const Coordinates &point, const T &value) {
+  FenwickWalk<0, kDimensions>::Update(point, sizes_, strides_, 0, [this, &value](size_t idx) {
+    tree_[idx] += value;
+  });
+}
+
+template<typename T, size_t kDimensions>
+T FenwickTree<T, kDimensions>::RSQ(const Coordinates &lhs, const Coordinates &rhs) const {
+  T sum = 0;
+  FenwickWalk<0, kDimensions>::Range(lhs, rhs, strides_, 0, false, [this, &sum](size_t idx, bool negative) {
+    if (negative) {
+      sum -= tree_[idx];
+    } else {
+      sum += tree_[idx];
+    }
+  });
+  return sum;
+}
+
+template<typename T, size_t kDimensions>
+void FenwickTree<T, kDimensions>::Prefetch(const Coordinates &point) const {
+  size_t idx = 0;
+  for (size_t dimension = 0; dimension < kDimensions; ++dimension) {
+    idx += point[dimension] * strides_[dimension];
+  }
+  __builtin_prefetch(&tree_[idx]);
+}
+
+template<typename T, size_t kDimensions>
+size_t FenwickTree<T, kDimensions>::GetSize(size_t dimension) const {
+  return sizes_[dimension];
+}
+
+////////// class RangeFenwickTree (Definition) //////////
+
+template<typename T, size_t kDimensions>
+RangeFenwickTree<T, kDimensions>::RangeFenwickTree(const Sizes &sizes) : sizes_(sizes) {
+  size_t cells_count = 1;
+  for (size_t dimension = kDimensions; dimension-- > 0;) {
+    strides_[dimension] = cells_count;
+    cells_count *= sizes_[dimension];
+  }
+  std::array<T, kTreesCount> zero;
+  zero.fill(T(0));
+  tree_.assign(cells_count, zero);
+}
+
+template<typename T, size_t kDimensions>
+void RangeFenwickTree<T, kDimensions>::AddToCorner(const Coordinates &corner, const T &value) {
+  std::array<T, kTreesCount> values;
+  values[0] = value;
+  for (size_t tree = 1; tree < kTreesCount; ++tree) {
+    const size_t dimension = __builtin_ctzll(tree);
+    values[tree] = values[tree & (tree - 1)] * static_cast<T>(corner[dimension]);
+  }
+  FenwickWalk<0, kDimensions>::Update(corner, sizes_, strides_, 0, [this, &values](size_t idx) {
+    for (size_t tree = 0; tree < kTreesCount; ++tree) {
+      tree_[idx][tree] += values[tree];
+    }
+  });
+}
+
+template<typename T, size_t kDimensions>
+T RangeFenwickTree<T, kDimensions>::PrefixSum(const Coordinates &point) const {
+  for (size_t dimension = 0; dimension < kDimensions; ++dimension) {
+    if (point[dimension] < 0) {
+      return 0;
+    }
+  }
+  std::array<T, kTreesCount> sums;
+  sums.fill(T(0));
+  FenwickWalk<0, kDimensions>::Prefix(point, strides_, 0, [this, &sums](size_t idx) {
+    for (size_t tree = 0; tree < kTreesCount; ++tree) {
+      sums[tree] += tree_[idx][tree];
+    }
+  });
+  T sum = 0;
+  for (size_t tree = 0; tree < kTreesCount; ++tree) {
+    T coefficient = (__builtin_popcountll(tree) % 2 == 0) ? T(1) : T(-1);
+    for (size_t dimension = 0; dimension < kDimensions; ++dimension) {
+      if ((tree >> dimension & 1) == 0) {
+        coefficient *= static_cast<T>(point[dimension] + 1);
+      }
+    }
+    sum += coefficient * sums[tree];
+  }
+  return sum;
+}
+
+template<typename T, size_t kDimensions>
+void RangeFenwickTree<T, kDimensions>::Update(const Coordinates &lhs, const Coordinates &rhs, const T &value) {
+  for (size_t corner_mask = 0; corner_mask < kTreesCount; ++corner_mask) {
+    Coordinates corner = lhs;
+    bool inside = true;
+    for (size_t dimension = 0; dimension < kDimensions; ++dimension) {
+      if (corner_mask >> dimension & 1) {
+        corner[dimension] = rhs[dimension] + 1;
+        inside = inside && static_cast<size_t>(corner[dimension]) < sizes_[dimension];
+      }
+    }
+    if (inside) {
+      AddToCorner(corner, (__builtin_popcountll(corner_mask) % 2 == 0) ? value : -value);
+    }
+  }
+}
+
+template<typename T, size_t kDimensions>
+T RangeFenwickTree<T, kDimensions>::RSQ(const Coordinates &lhs, const Coordinates &rhs) const {
+  T sum = 0;
+  for (size_t corner_mask = 0; corner_mask < kTreesCount; ++corner_mask) {
+    Coordinates corner = rhs;
+    for (size_t dimension = 0; dimension < kDimensions; ++dimension) {
+      if (corner_mask >> dimension & 1) {
+        corner[dimension] = lhs[dimension] - 1;
+      }
+    }
+    if (__builtin_popcountll(corner_mask) % 2 == 0) {
+      sum += PrefixSum(corner);
+    } else {
+      sum -= PrefixSum(corner);
+    }
+  }
+  return sum;
+}
+
+template<typename T, size_t kDimensions>
+size_t RangeFenwickTree<T, kDimensions>::GetSize(size_t dimension) const {
+  return sizes_[dimension];
+}
+
 template<typename T>
 class FenwickTree_2D {
  private:
-  std::vector<std::vector<T>> tree_;
+  FenwickTree<T, 2> tree_;
 
-  T RSQ(const Point &point) const;
+  static std::array<int64_t, 2> ToCoordinates(const Point &point);
  public:
   explicit FenwickTree_2D(size_t height, size_t width);
   T RSQ(const Point &lhs, const Point &rhs) const;
+  std::vector<T> RSQ(const std::vector<std::pair<Point, Point>> &rectangles) const;
   void Update(const Point &point, const T &value);
   size_t GetWidth() const;
   size_t GetHeight() const;
 };
 
 template<typename T>
-FenwickTree_2D<T>::FenwickTree_2D(size_t height, size_t width) : tree_(height, std::vector<T>(width)) {}
+FenwickTree_2D<T>::FenwickTree_2D(size_t height, size_t width) : tree_({height, width}) {}
+
+template<typename T>
+std::array<int64_t, 2> FenwickTree_2D<T>::ToCoordinates(const Point &point) {
+  return {point.x_, point.y_};
+}
+
+template<typename T>
+T FenwickTree_2D<T>::RSQ(const Point &lhs, const Point &rhs) const {
+  return tree_.RSQ(ToCoordinates(lhs), ToCoordinates(rhs));
+}
+
+// Rectangles are ordered by the row of their far corner: the prefix walks of neighbouring ones share rows.
+template<typename T>
+std::vector<T> FenwickTree_2D<T>::RSQ(const std::vector<std::pair<Point, Point>> &rectangles) const {
+  const auto sorted = SortQueries(rectangles, GetHeight(), [](const std::pair<Point, Point> &rectangle) {
+    return static_cast<size_t>(rectangle.second.x_);
+  });
+  std::vector<T> answers(rectangles.size());
+  AnswerSortedQueries(sorted, answers,
+                      [this](const std::pair<Point, Point> &rectangle) {
+                        return RSQ(rectangle.first, rectangle.second);
+                      },
+                      [this](const std::pair<Point, Point> &rectangle) {
+                        tree_.Prefetch(ToCoordinates(rectangle.second));
+                      });
+  return answers;
+}
 
 template<typename T>
-T FenwickTree_2D<T>::RSQ(const Point &point) const {
+size_t FenwickTree_2D<T>::GetWidth() const {
+  return tree_.GetSize(1);
+}
+
+template<typename T>
+size_t FenwickTree_2D<T>::GetHeight() const {
+  return tree_.GetSize(0);
+}
+
+template<typename T>
+void FenwickTree_2D<T>::Update(const Point &point, const T &value) {
+  tree_.Update(ToCoordinates(point), value);
+}
+
+/* Offline 2D Fenwick tree over arbitrary coordinates: every point that will be updated is known in advance. Rows are
+ compressed to the distinct x of the points, and row node i keeps the sorted distinct y of the points whose update walk
+ passes through it, together with a 1D Fenwick tree over them. Node lists are stored back to back in one array, so
+ memory is O(points * log points) however large the coordinates are. */
+template<typename T>
+class OfflineFenwickTree_2D {
+ private:
+  std::vector<int64_t> rows_;
+  std::vector<size_t> columns_begin_;
+  std::vector<int64_t> columns_;
+  std::vector<T> tree_;
+
+  T RSQ(const Point &point) const;
+ public:
+  explicit OfflineFenwickTree_2D(const std::vector<Point> &points);
+  T RSQ(const Point &lhs, const Point &rhs) const;
+  // point must be one of the points the tree was built for.
+  void Update(const Point &point, const T &value);
+};
+
+/* Online 2D Fenwick tree over a height x width grid that keeps only the cells touched by updates, in a hash map keyed
+ by the flat cell index. Memory is O(updates * log height * log width), queries pay a hash lookup per visited cell. */
+template<typename T>
+class HashFenwickTree_2D {
+ private:
+  size_t height_;
+  size_t width_;
+  std::unordered_map<uint64_t, T> tree_;
+
+  T RSQ(const Point &point) const;
+ public:
+  explicit HashFenwickTree_2D(size_t height, size_t width);
+  T RSQ(const Point &lhs, const Point &rhs) const;
+  void Update(const Point &point, const T &value);
+  size_t GetWidth() const;
+  size_t GetHeight() const;
+};
+
+template<typename T>
+OfflineFenwickTree_2D<T>::OfflineFenwickTree_2D(const std::vector<Point> &points) {
+  for (const Point &point : points) {
+    rows_.push_back(point.x_);
+  }
+  std::sort(rows_.begin(), rows_.end());
+  rows_.erase(std::unique(rows_.begin(), rows_.end()), rows_.end());
+  std::vector<size_t> points_rows(points.size());
+  columns_begin_.assign(rows_.size() + 1, 0);
+  for (size_t idx = 0; idx < points.size(); ++idx) {
+    points_rows[idx] = std::lower_bound(rows_.begin(), rows_.end(), points[idx].x_) - rows_.begin();
+    for (size_t i = points_rows[idx]; i < rows_.size(); i = (i | (i + 1))) {
+      ++columns_begin_[i + 1];
+    }
+  }
+  for (size_t i = 0; i < rows_.size(); ++i) {
+    columns_begin_[i + 1] += columns_begin_[i];
+  }
+  // Columns are bucketed by node, then every node list is sorted, deduplicated and moved down to close the gaps.
+  std::vector<size_t> node_end(columns_begin_.begin(), columns_begin_.end() - 1);
+  columns_.resize(columns_begin_.back());
+  for (size_t idx = 0; idx < points.size(); ++idx) {
+    for (size_t i = points_rows[idx]; i < rows_.size(); i = (i | (i + 1))) {
+      columns_[node_end[i]++] = points[idx].y_;
+    }
+  }
+  size_t columns_count = 0;
+  for (size_t i = 0; i < rows_.size(); ++i) {
+    const auto node_begin = columns_.begin() + columns_begin_[i];
+    std::sort(node_begin, columns_.begin() + node_end[i]);
+    const auto unique_end = std::unique(node_begin, columns_.begin() + node_end[i]);
+    columns_begin_[i] = columns_count;
+    columns_count = std::move(node_begin, unique_end, columns_.begin() + columns_count) - columns_.begin();
+  }
+  columns_begin_[rows_.size()] = columns_count;
+  columns_.resize(columns_count);
+  columns_.shrink_to_fit();
+  tree_.assign(columns_.size(), T(0));
+}
+
+template<typename T>
+T OfflineFenwickTree_2D<T>::RSQ(const Point &point) const {
   T sum = 0;
-  for (int64_t i = point.x_; i >= 0; i = ((i & (i + 1)) - 1)) {
-    for (int64_t j = point.y_; j >= 0; j = ((j & (j + 1)) - 1)) {
-      sum += tree_[i][j];
+  const int64_t row = std::upper_bound(rows_.begin(), rows_.end(), point.x_) - rows_.begin() - 1;
+  for (int64_t i = row; i >= 0; i = ((i & (i + 1)) - 1)) {
+    const auto columns_begin = columns_.begin() + columns_begin_[i];
+    const auto columns_end = columns_.begin() + columns_begin_[i + 1];
+    const int64_t column = std::upper_bound(columns_begin, columns_end, point.y_) - columns_begin - 1;
+    for (int64_t j = column; j >= 0; j = ((j & (j + 1)) - 1)) {
+      sum += tree_[columns_begin_[i] + j];
     }
   }
   return sum;
 }
 
 template<typename T>
-T FenwickTree_2D<T>::RSQ(const Point &lhs, const Point &rhs) const {
+T OfflineFenwickTree_2D<T>::RSQ(const Point &lhs, const Point &rhs) const {
   return RSQ(Point(rhs.x_, rhs.y_)) -
          RSQ(Point(lhs.x_ - 1, rhs.y_)) -
          RSQ(Point(rhs.x_, lhs.y_ - 1)) +
@@ -75,29 +498,75 @@ T FenwickTree_2D<T>::RSQ(const Point &lhs, const Point &rhs) const {
 }
 
 template<typename T>
-size_t FenwickTree_2D<T>::GetWidth() const {
-  return tree_[0].size();
+void OfflineFenwickTree_2D<T>::Update(const Point &point, const T &value) {
+  const size_t row = std::lower_bound(rows_.begin(), rows_.end(), point.x_) - rows_.begin();
+  for (size_t i = row; i < rows_.size(); i = (i | (i + 1))) {
+    const auto columns_begin = columns_.begin() + columns_begin_[i];
+    const size_t columns_count = columns_begin_[i + 1] - columns_begin_[i];
+    const size_t column = std::lower_bound(columns_begin, columns_begin + columns_count, point.y_) - columns_begin;
+    for (size_t j = column; j < columns_count; j = (j | (j + 1))) {
+      tree_[columns_begin_[i] + j] += value;
+    }
+  }
 }
 
 template<typename T>
-size_t FenwickTree_2D<T>::GetHeight() const {
-  return tree_.size();
+HashFenwickTree_2D<T>::HashFenwickTree_2D(size_t height, size_t width) : height_(height), width_(width) {}
+
+template<typename T>
+T HashFenwickTree_2D<T>::RSQ(const Point &point) const {
+  T sum = 0;
+  for (int64_t i = std::min<int64_t>(point.x_, height_ - 1); i >= 0; i = ((i & (i + 1)) - 1)) {
+    for (int64_t j = std::min<int64_t>(point.y_, width_ - 1); j >= 0; j = ((j & (j + 1)) - 1)) {
+      auto cell = tree_.find(static_cast<uint64_t>(i) * width_ + j);
+      if (cell != tree_.end()) {
+        sum += cell->second;
+      }
+    }
+  }
+  return sum;
 }
 
 template<typename T>
-void FenwickTree_2D<T>::Update(const Point &point, const T &value) {
-  for (size_t i = point.x_; i < GetHeight(); i = (i | (i + 1))) {
-    for (size_t j = point.y_; j < GetWidth(); j = (j | (j + 1))) {
-      tree_[i][j] += value;
+T HashFenwickTree_2D<T>::RSQ(const Point &lhs, const Point &rhs) const {
+  return RSQ(Point(rhs.x_, rhs.y_)) -
+         RSQ(Point(lhs.x_ - 1, rhs.y_)) -
+         RSQ(Point(rhs.x_, lhs.y_ - 1)) +
+         RSQ(Point(lhs.x_ - 1, lhs.y_ - 1));
+}
+
+template<typename T>
+void HashFenwickTree_2D<T>::Update(const Point &point, const T &value) {
+  for (size_t i = point.x_; i < height_; i = (i | (i + 1))) {
+    for (size_t j = point.y_; j < width_; j = (j | (j + 1))) {
+      tree_[static_cast<uint64_t>(i) * width_ + j] += value;
     }
   }
 }
 
+template<typename T>
+size_t HashFenwickTree_2D<T>::GetWidth() const {
+  return width_;
+}
+
+template<typename T>
+size_t HashFenwickTree_2D<T>::GetHeight() const {
+  return height_;
+}
+
 int main() {
   size_t x, y;
   size_t n;
   std::cin >> x >> y >> n;
   FenwickTree_2D<int64_t> fenwick_tree(x, y);
+  // Consecutive questions are answered in one batch before the next event.
+  std::vector<std::pair<Point, Point>> rectangles;
+  auto answer_rectangles = [&fenwick_tree, &rectangles]() {
+    for (int64_t sum : fenwick_tree.RSQ(rectangles)) {
+      std::cout << sum << std::endl;
+    }
+    rectangles.clear();
+  };
   for (size_t i = 0; i < n; ++i) {
     int query;
     std::cin >> query;
@@ -105,13 +574,15 @@ int main() {
       int64_t x1, y1;
       int64_t value;
       std::cin >> x1 >> y1 >> value;
+      answer_rectangles();
       fenwick_tree.Update(Point(x1 - 1, y1 - 1), value);
     } else if (query == 2) {
       int64_t x1, y1, x2, y2;
       std::cin >> x1 >> y1 >> x2 >> y2;
-      std::cout << fenwick_tree.RSQ(Point(x1 - 1, y1 - 1), Point(x2 - 1, y2 - 1)) << std::endl;
+      rectangles.emplace_back(Point(x1 - 1, y1 - 1), Point(x2 - 1, y2 - 1));
     }
   }
+  answer_rectangles();
 
   return 0;
 }
\ No newline at end of file
@@ -37,6 +37,7 @@ Input	          Output
 
 #include <iostream>
 #include <vector>
+#include <array>
 
 struct Point {
   int64_t x_;
@@ -46,12 +47,267 @@ struct Point {
   Point(int64_t x, int64_t y, int64_t z) : x_(x), y_(y), z_(z) {}
 };
 
+////////// class FenwickTree (Declaration) //////////
+
+/* Index walks of an N-dimensional Fenwick tree stored in one flat array (last coordinate contiguous). The loop over
+ dimension kDimension calls the walk of the next dimension, the recursion is instantiated per dimension and unrolled
+ by the compiler; visit gets the flat index of every cell on the walk. */
+template<size_t kDimension, size_t kDimensions>
+struct FenwickWalk {
+  using Coordinates = std::array<int64_t, kDimensions>;
+  using Sizes = std::array<size_t, kDimensions>;
+
+  template<typename Visit>
+  static void Update(const Coordinates &point, const Sizes &sizes, const Sizes &strides, size_t offset,
+                     const Visit &visit) {
+    for (size_t i = point[kDimension]; i < sizes[kDimension]; i = (i | (i + 1))) {
+      FenwickWalk<kDimension + 1, kDimensions>::Update(point, sizes, strides, offset + i * strides[kDimension], visit);
+    }
+  }
+
+  template<typename Visit>
+  static void Prefix(const Coordinates &point, const Sizes &strides, size_t offset, const Visit &visit) {
+    for (int64_t i = point[kDimension]; i >= 0; i = ((i & (i + 1)) - 1)) {
+      FenwickWalk<kDimension + 1, kDimensions>::Prefix(point, strides, offset + i * strides[kDimension], visit);
+    }
+  }
+
+  // Walks rhs and lhs - 1 down together; the cells both prefixes share cancel out and are skipped.
+  template<typename Visit>
+  static void Range(const Coordinates &lhs, const Coordinates &rhs, const Sizes &strides, size_t offset,
+                    bool negative, const Visit &visit) {
+    int64_t i = rhs[kDimension];
+    int64_t j = lhs[kDimension] - 1;
+    while (i != j) {
+      if (i > j) {
+        FenwickWalk<kDimension + 1, kDimensions>::Range(lhs, rhs, strides, offset + i * strides[kDimension],
+                                                        negative, visit);
+        i = ((i & (i + 1)) - 1);
+      } else {
+        FenwickWalk<kDimension + 1, kDimensions>::Range(lhs, rhs, strides, offset + j * strides[kDimension],
+                                                        !negative, visit);
+        j = ((j & (j + 1)) - 1);
+      }
+    }
+  }
+};
+
+template<size_t kDimensions>
+struct FenwickWalk<kDimensions, kDimensions> {
+  using Coordinates = std::array<int64_t, kDimensions>;
+  using Sizes = std::array<size_t, kDimensions>;
+
+  template<typename Visit>
+  static void Update(const Coordinates &, const Sizes &, const Sizes &, size_t offset, const Visit &visit) {
+    visit(offset);
+  }
+
+  template<typename Visit>
+  static void Prefix(const Coordinates &, const Sizes &, size_t offset, const Visit &visit) {
+    visit(offset);
+  }
+
+  template<typename Visit>
+  static void Range(const Coordinates &, const Coordinates &, const Sizes &, size_t offset, bool negative,
+                    const Visit &visit) {
+    visit(offset, negative);
+  }
+};
+
+// Point update and box sum over a flat kDimensions-dimensional array; coordinates are 0-indexed, boxes inclusive.
+template<typename T, size_t kDimensions>
+class FenwickTree {
+ public:
+  using Coordinates = std::array<int64_t, kDimensions>;
+  using Sizes = std::array<size_t, kDimensions>;
+
+ private:
+  Sizes sizes_;
+  Sizes strides_;
+  std::vector<T> tree_;
+
+ public:
+  explicit FenwickTree(const Sizes &sizes);
+  void Update(const Coordinates &point, const T &value);
+  T RSQ(const Coordinates &lhs, const Coordinates &rhs) const;
+  void Prefetch(const Coordinates &point) const;
+  size_t GetSize(size_t dimension) const;
+};
+
+/* Range add and box sum with 2^kDimensions trees. An add on a box is 2^kDimensions signed point adds d(q) at its
+ corners, and the prefix sum up to x is the sum over q <= x of d(q) * prod_k (x_k + 1 - q_k). Expanding the product,
+ tree S stores d(q) * prod_{k in S} q_k; the trees are interleaved so one walk updates or reads all of them. */
+template<typename T, size_t kDimensions>
+class RangeFenwickTree {
+ public:
+  using Coordinates = std::array<int64_t, kDimensions>;
+  using Sizes = std::array<size_t, kDimensions>;
+
+ private:
+  static constexpr size_t kTreesCount = size_t(1) << kDimensions;
+
+  Sizes sizes_;
+  Sizes strides_;
+  std::vector<std::array<T, kTreesCount>> tree_;
+
+  void AddToCorner(const Coordinates &corner, const T &value);
+  T PrefixSum(const Coordinates &point) const;
+ public:
+  explicit RangeFenwickTree(const Sizes &sizes);
+  void Update(const Coordinates &lhs, const Coordinates &rhs, const T &value);
+  T RSQ(const Coordinates &lhs, const Coordinates &rhs) const;
+  size_t GetSize(size_t dimension) const;
+};
+
+////////// class FenwickTree (Definition) //////////
+
+template<typename T, size_t kDimensions>
+FenwickTree<T, kDimensions>::FenwickTree(const Sizes &sizes) : sizes_(sizes) {
+  size_t cells_count = 1;
+  for (size_t dimension = kDimensions; dimension-- > 0;) {
+    strides_[dimension] = cells_count;
+    cells_count *= sizes_[dimension];
+  }
+  tree_.assign(cells_count, T(0));
+}
+
+template<typename T, size_t kDimensions>
+void FenwickTree<T, kDimensions>::Update(const Coordinates &point, const T &value) {
+  FenwickWalk<0, kDimensions>::Update(point, sizes_, strides_, 0, [this, &value](size_t idx) {
+    tree_[idx] += value;
+  });
+}
+
+template<typename T, size_t kDimensions>
+T FenwickTree<T, kDimensions>::RSQ(const Coordinates &lhs, const Coordinates &rhs) const {
+  T sum = 0;
+  FenwickWalk<0, kDimensions>::Range(lhs, rhs, strides_, 0, false, [this, &sum](size_t idx, bool negative) {
+    if (negative) {
+      sum -= tree_[idx];
+    } else {
+      sum += tree_[idx];
+    }
+  });
+  return sum;
+}
+
+template<typename T, size_t kDimensions>
+void FenwickTree<T, kDimensions>::Prefetch(const Coordinates &point) const {
+  size_t idx = 0;
+  for (size_t dimension = 0; dimension < kDimensions; ++dimension) {
+    idx += point[dimension] * strides_[dimension];
+  }
+  __builtin_prefetch(&tree_[idx]);
+}
+
+template<typename T, size_t kDimensions>
+size_t FenwickTree<T, kDimensions>::GetSize(size_t dimension) const {
+  return sizes_[dimension];
+}
+
+////////// class RangeFenwickTree (Definition) //////////
+
+template<typename T, size_t kDimensions>
+RangeFenwickTree<T, kDimensions>::RangeFenwickTree(const Sizes &sizes) : sizes_(sizes) {
+  size_t cells_count = 1;
+  for (size_t dimension = kDimensions; dimension-- > 0;) {
+    strides_[dimension] = cells_count;
+    cells_count *= sizes_[dimension];
+  }
+  std::array<T, kTreesCount> zero;
+  zero.fill(T(0));
+  tree_.assign(cells_count, zero);
+}
+
+template<typename T, size_t kDimensions>
+void RangeFenwickTree<T, kDimensions>::AddToCorner(const Coordinates &corner, const T &value) {
+  std::array<T, kTreesCount> values;
+  values[0] = value;
+  for (size_t tree = 1; tree < kTreesCount; ++tree) {
+    const size_t dimension = __builtin_ctzll(tree);
+    values[tree] = values[tree & (tree - 1)] * static_cast<T>(corner[dimension]);
+  }
+  FenwickWalk<0, kDimensions>::Update(corner, sizes_, strides_, 0, [this, &values](size_t idx) {
+    for (size_t tree = 0; tree < kTreesCount; ++tree) {
+      tree_[idx][tree] += values[tree];
+    }
+  });
+}
+
+template<typename T, size_t kDimensions>
+T RangeFenwickTree<T, kDimensions>::PrefixSum(const Coordinates &point) const {
+  for (size_t dimension = 0; dimension < kDimensions; ++dimension) {
+    if (point[dimension] < 0) {
+      return 0;
+    }
+  }
+  std::array<T, kTreesCount> sums;
+  sums.fill(T(0));
+  FenwickWalk<0, kDimensions>::Prefix(point, strides_, 0, [this, &sums](size_t idx) {
+    for (size_t tree = 0; tree < kTreesCount; ++tree) {
+      sums[tree] += tree_[idx][tree];
+    }
+  });
+  T sum = 0;
+  for (size_t tree = 0; tree < kTreesCount; ++tree) {
+    T coefficient = (__builtin_popcountll(tree) % 2 == 0) ? T(1) : T(-1);
+    for (size_t dimension = 0; dimension < kDimensions; ++dimension) {
+      if ((tree >> dimension & 1) == 0) {
+        coefficient *= static_cast<T>(point[dimension] + 1);
+      }
+    }
+    sum += coefficient * sums[tree];
+  }
+  return sum;
+}
+
+template<typename T, size_t kDimensions>
+void RangeFenwickTree<T, kDimensions>::Update(const Coordinates &lhs, const Coordinates &rhs, const T &value) {
+  for (size_t corner_mask = 0; corner_mask < kTreesCount; ++corner_mask) {
+    Coordinates corner = lhs;
+    bool inside = true;
+    for (size_t dimension = 0; dimension < kDimensions; ++dimension) {
+      if (corner_mask >> dimension & 1) {
+        corner[dimension] = rhs[dimension] + 1;
+        inside = inside && static_cast<size_t>(corner[dimension]) < sizes_[dimension];
+      }
+    }
+    if (inside) {
+      AddToCorner(corner, (__builtin_popcountll(corner_mask) % 2 == 0) ? value : -value);
+    }
+  }
+}
+
+template<typename T, size_t kDimensions>
+T RangeFenwickTree<T, kDimensions>::RSQ(const Coordinates &lhs, const Coordinates &rhs) const {
+  T sum = 0;
+  for (size_t corner_mask = 0; corner_mask < kTreesCount; ++corner_mask) {
+    Coordinates corner = rhs;
+    for (size_t dimension = 0; dimension < kDimensions; ++dimension) {
+      if (corner_mask >> dimension & 1) {
+        corner[dimension] = lhs[dimension] - 1;
+      }
+    }
+    if (__builtin_popcountll(corner_mask) % 2 == 0) {
+      sum += PrefixSum(corner);
+    } else {
+      sum -= PrefixSum(corner);
+    }
+  }
+  return sum;
+}
+
+template<typename T, size_t kDimensions>
+size_t RangeFenwickTree<T, kDimensions>::GetSize(size_t dimension) const {
+  return sizes_[dimension];
+}
+
 template<typename T>
 class FenwickTree_3D {
  private:
-  std::vector<std::vector<std::vector<T>>> tree_;
+  FenwickTree<T, 3> tree_;
 
-  T RSQ(const Point &point) const;
+  static std::array<int64_t, 3> ToCoordinates(const Point &point);
  public:
   explicit FenwickTree_3D(size_t height, size_t length, size_t width);
   T RSQ(const Point &lhs, const Point &rhs) const;
@@ -62,54 +318,36 @@ class FenwickTree_3D {
 };
 
 template<typename T>
-FenwickTree_3D<T>::FenwickTree_3D(size_t height, size_t length, size_t width)
-    : tree_(height, std::vector<std::vector<T>>(length, std::vector<T>(width))) {}
+FenwickTree_3D<T>::FenwickTree_3D(size_t height, size_t length, size_t width) : tree_({height, length, width}) {}
 
 template<typename T>
-T FenwickTree_3D<T>::RSQ(const Point &point) const {
-  T sum = 0;
-  for (int64_t i = point.x_; i >= 0; i = ((i & (i + 1)) - 1)) {
-    for (int64_t j = point.y_; j >= 0; j = ((j & (j + 1)) - 1)) {
-      for (int64_t k = point.z_; k >= 0; k = ((k & (k + 1)) - 1)) {
-        sum += tree_[i][j][k];
-      }
-    }
-  }
-  return sum;
+std::array<int64_t, 3> FenwickTree_3D<T>::ToCoordinates(const Point &point) {
+  return {point.x_, point.y_, point.z_};
 }
 
 template<typename T>
 T FenwickTree_3D<T>::RSQ(const Point &lhs, const Point &rhs) const {
-  return RSQ(Point(rhs.x_, rhs.y_, rhs.z_)) - RSQ(Point(lhs.x_ - 1, rhs.y_, rhs.z_)) -
-        RSQ(Point(rhs.x_, lhs.y_ - 1, rhs.z_)) - RSQ(Point(rhs.x_, rhs.y_, lhs.z_ - 1)) +
-        RSQ(Point(lhs.x_ - 1, lhs.y_ - 1, rhs.z_)) + RSQ(Point(lhs.x_ - 1, rhs.y_, lhs.z_ - 1)) +
-        RSQ(Point(rhs.x_, lhs.y_ - 1, lhs.z_ - 1)) - RSQ(Point(lhs.x_ - 1, lhs.y_ - 1, lhs.z_ - 1));
+  return tree_.RSQ(ToCoordinates(lhs), ToCoordinates(rhs));
 }
 
 template<typename T>
 size_t FenwickTree_3D<T>::GetLength() const {
-  return tree_[0].size();
+  return tree_.GetSize(1);
 }
 
 template<typename T>
 size_t FenwickTree_3D<T>::GetHeight() const {
-  return tree_.size();
+  return tree_.GetSize(0);
 }
 
 template<typename T>
 size_t FenwickTree_3D<T>::GetWidth() const {
-  return tree_[0][0].size();
+  return tree_.GetSize(2);
 }
 
 template<typename T>
 void FenwickTree_3D<T>::Update(const Point &point, const T &value) {
-  for (size_t i = point.x_; i < GetHeight(); i = (i | (i + 1))) {
-    for (size_t j = point.y_; j < GetLength(); j = (j | (j + 1))) {
-      for (size_t k = point.z_; k < GetWidth(); k = (k | (k + 1))) {
-        tree_[i][j][k] += value;
-      }
-    }
-  }
+  tree_.Update(ToCoordinates(point), value);
 }
 
 int main() {
@@ -28,6 +28,11 @@ Input	Output
 #include <vector>
 #include <algorithm>
 #include <limits>
+#include <queue>
+#include <utility>
+#include <atomic>
+#include <memory>
+#include <thread>
 
 ////////////////////////////// class FlowNetwork //////////////////////////////
 
@@ -35,36 +40,67 @@ class FlowNetwork {
  private:
   typedef size_t Vertex;
   typedef int64_t Flow;
+  typedef int64_t Cost;
 
   struct FlowEdge {
     Vertex from;
     Vertex to;
-    size_t flow;
-    size_t capacity;
+    Flow flow;
+    Flow capacity;
+    Cost cost;
 
     explicit FlowEdge() = default;
-    explicit FlowEdge(const Vertex &from, const Vertex &to, const Flow &capacity);
+    explicit FlowEdge(const Vertex &from, const Vertex &to, const Flow &capacity, const Cost &cost = 0);
     Flow ResidualCapacity() const;
   };
 
   std::vector<FlowEdge> index_edge_;
   std::vector<std::vector<size_t>> adj_list_;
   std::vector<bool> visited_;
+  std::vector<size_t> level_;
+  std::vector<size_t> current_arc_;
+  std::vector<Flow> excess_;
+  std::vector<size_t> height_;
+  std::vector<size_t> height_count_;
+  std::vector<std::vector<Vertex>> active_by_height_;
+  size_t highest_active_;
   size_t vertex_count_;
   size_t edge_count_;
   Vertex source_, termination_;
-  Flow DFS(const Vertex &vertex, const Flow &flow_upper_bound);
+  size_t augmenting_paths_count_;
+  Flow DFS(const Vertex &vertex, const Flow &flow_upper_bound, const Flow &min_residual_capacity);
+  bool BuildLevelGraph();
+  Flow PushBlockingFlow();
+  std::vector<size_t> GetDistancesToTermination() const;
+  void GlobalRelabel();
+  void Activate(const Vertex &vertex);
+  void Push(size_t index);
+  void Relabel(const Vertex &vertex);
+  void Discharge(const Vertex &vertex);
+  std::vector<Cost> GetInitialPotentials() const;
+  bool FindCheapestPath(std::vector<Cost> &potential, std::vector<size_t> &parent_edge) const;
+  struct ConcurrentPreflow;
+  void DischargeConcurrently(ConcurrentPreflow &preflow, size_t thread_id, size_t threads_count) const;
  public:
 
   FlowNetwork(size_t vertex_count, size_t edges_count, const Vertex &source, const Vertex &termination);
   Flow GetMaxFlow_FordFulkerson();
-  Flow PushFlow(const Vertex &vertex, const Flow &flow_upper_bound);
+  Flow GetMaxFlow_CapacityScaling();
+  size_t GetAugmentingPathsCount() const;
+  Flow GetMaxFlow_Dinic();
+  Flow GetMaxFlow_PushRelabel();
+  Flow GetMaxFlow_ParallelPushRelabel(size_t threads_count = std::thread::hardware_concurrency());
+  std::vector<Vertex> GetMinCutSourceSide() const;
+  std::pair<Flow, Cost> GetMinCostMaxFlow(const Flow &flow_limit = std::numeric_limits<Flow>::max());
+  void ResetFlow();
+  Flow PushFlow(const Vertex &vertex, const Flow &flow_upper_bound, const Flow &min_residual_capacity = 1);
   void AddEdge(const Vertex &from, const Vertex &to, const Flow &capacity, size_t index);
+  void AddEdge(const Vertex &from, const Vertex &to, const Flow &capacity, const Cost &cost, size_t index);
   Vertex GetSource() const;
   Vertex GetTermination() const;
   size_t GetVertexCount() const;
   FlowEdge &GetBackEdge(size_t index);
-  std::vector<size_t> GetEdgesIndicesIncidentOn(const Vertex &vertex) const;
+  const std::vector<size_t> &GetEdgesIndicesIncidentOn(const Vertex &vertex) const;
 };
 
 ////////////////////////////// class FlowNetwork //////////////////////////////
@@ -76,7 +112,11 @@ FlowNetwork::FlowNetwork(size_t vertex_count, size_t edges_count, const Vertex &
       index_edge_(2 * edges_count),
       adj_list_(vertex_count),
       termination_(termination),
-      visited_(vertex_count, false) {}
+      visited_(vertex_count, false),
+      level_(vertex_count),
+      current_arc_(vertex_count),
+      highest_active_(0),
+      augmenting_paths_count_(0) {}
 
 void FlowNetwork::AddEdge(const Vertex &from, const Vertex &to, const Flow &capacity, size_t index) {
   index_edge_[2 * index] = FlowEdge(from, to, capacity);
@@ -85,7 +125,14 @@ void FlowNetwork::AddEdge(const Vertex &from, const Vertex &to, const Flow &capa
   adj_list_[to].push_back(2 * index + 1);
 }
 
-std::vector<size_t> FlowNetwork::GetEdgesIndicesIncidentOn(const FlowNetwork::Vertex &vertex) const {
+void FlowNetwork::AddEdge(const Vertex &from, const Vertex &to, const Flow &capacity, const Cost &cost, size_t index) {
+  index_edge_[2 * index] = FlowEdge(from, to, capacity, cost);
+  index_edge_[2 * index + 1] = FlowEdge(to, from, 0, -cost);
+  adj_list_[from].push_back(2 * index);
+  adj_list_[to].push_back(2 * index + 1);
+}
+
+const std::vector<size_t> &FlowNetwork::GetEdgesIndicesIncidentOn(const FlowNetwork::Vertex &vertex) const {
   return adj_list_[vertex];
 }
 
@@ -105,11 +152,18 @@ FlowNetwork::FlowEdge &FlowNetwork::GetBackEdge(size_t index) {
   return index_edge_[index ^ 1];
 }
 
+void FlowNetwork::ResetFlow() {
+  for (auto &flow_edge : index_edge_) {
+    flow_edge.flow = 0;
+  }
+}
+
 ////////////////////////////// FordFulkerson Algorithm //////////////////////////////
 
 FlowNetwork::Flow FlowNetwork::GetMaxFlow_FordFulkerson() {
   const Flow INF = std::numeric_limits<Flow>::max();
   Flow max_flow = 0, blocking_flow = INF;
+  augmenting_paths_count_ = 0;
   while (blocking_flow != 0) {
     blocking_flow = PushFlow(source_, INF);
     max_flow += blocking_flow;
@@ -117,12 +171,22 @@ FlowNetwork::Flow FlowNetwork::GetMaxFlow_FordFulkerson() {
   return max_flow;
 }
 
-FlowNetwork::Flow FlowNetwork::PushFlow(const Vertex &vertex, const Flow &flow_upper_bound) {
+FlowNetwork::Flow FlowNetwork::PushFlow(const Vertex &vertex, const Flow &flow_upper_bound,
+                                        const Flow &min_residual_capacity) {
   visited_.assign(vertex_count_, false);
-  return DFS(vertex, flow_upper_bound);
+  Flow delta = DFS(vertex, flow_upper_bound, min_residual_capacity);
+  if (delta > 0) {
+    ++augmenting_paths_count_;
+  }
+  return delta;
 }
 
-FlowNetwork::Flow FlowNetwork::DFS(const Vertex &vertex, const Flow &flow_upper_bound) {
+size_t FlowNetwork::GetAugmentingPathsCount() const {
+  return augmenting_paths_count_;
+}
+
+FlowNetwork::Flow FlowNetwork::DFS(const Vertex &vertex, const Flow &flow_upper_bound,
+                                   const Flow &min_residual_capacity) {
   if (vertex == termination_) {
     return flow_upper_bound;
   }
@@ -130,8 +194,8 @@ FlowNetwork::Flow FlowNetwork::DFS(const Vertex &vertex, const Flow &flow_upper_
   for (size_t index : GetEdgesIndicesIncidentOn(vertex)) {
     FlowEdge &flow_edge = index_edge_[index];
     Vertex adj_vertex = flow_edge.to;
-    if (!visited_[adj_vertex] && flow_edge.ResidualCapacity() > 0) {
-      Flow delta = DFS(adj_vertex, std::min(flow_upper_bound, flow_edge.ResidualCapacity()));
+    if (!visited_[adj_vertex] && flow_edge.ResidualCapacity() >= min_residual_capacity) {
+      Flow delta = DFS(adj_vertex, std::min(flow_upper_bound, flow_edge.ResidualCapacity()), min_residual_capacity);
       if (delta > 0) {
         flow_edge.flow += delta;
         FlowEdge &back_flow_edge = GetBackEdge(index);
@@ -143,13 +207,470 @@ FlowNetwork::Flow FlowNetwork::DFS(const Vertex &vertex, const Flow &flow_upper_
   return 0;
 }
 
+////////////////////////////// Capacity Scaling //////////////////////////////
+
+/* Ford-Fulkerson restricted to residual edges of capacity at least delta, halving delta after each phase.
+ Every phase performs at most 2 * edges augmentations, so the path count is O(E log U) instead of O(F). */
+FlowNetwork::Flow FlowNetwork::GetMaxFlow_CapacityScaling() {
+  const Flow INF = std::numeric_limits<Flow>::max();
+  Flow max_capacity = 0;
+  for (const auto &flow_edge : index_edge_) {
+    max_capacity = std::max(max_capacity, flow_edge.capacity);
+  }
+  Flow delta = 1;
+  while (delta <= max_capacity / 2) {
+    delta *= 2;
+  }
+  Flow max_flow = 0;
+  augmenting_paths_count_ = 0;
+  for (; delta > 0; delta /= 2) {
+    Flow pushed_flow;
+    while ((pushed_flow = PushFlow(source_, INF, delta)) > 0) {
+      max_flow += pushed_flow;
+    }
+  }
+  return max_flow;
+}
+
+////////////////////////////// Dinic Algorithm //////////////////////////////
+
+FlowNetwork::Flow FlowNetwork::GetMaxFlow_Dinic() {
+  Flow max_flow = 0;
+  while (BuildLevelGraph()) {
+    current_arc_.assign(vertex_count_, 0);
+    max_flow += PushBlockingFlow();
+  }
+  return max_flow;
+}
+
+bool FlowNetwork::BuildLevelGraph() {
+  const size_t NOT_REACHED = std::numeric_limits<size_t>::max();
+  level_.assign(vertex_count_, NOT_REACHED);
+  std::vector<Vertex> queue;
+  queue.reserve(vertex_count_);
+  queue.push_back(source_);
+  level_[source_] = 0;
+  for (size_t head = 0; head < queue.size() && level_[termination_] == NOT_REACHED; ++head) {
+    Vertex vertex = queue[head];
+    for (size_t index : adj_list_[vertex]) {
+      const FlowEdge &flow_edge = index_edge_[index];
+      if (flow_edge.ResidualCapacity() > 0 && level_[flow_edge.to] == NOT_REACHED) {
+        level_[flow_edge.to] = level_[vertex] + 1;
+        queue.push_back(flow_edge.to);
+      }
+    }
+  }
+  return level_[termination_] != NOT_REACHED;
+}
+
+/* Iterative DFS over the level graph. current_arc_[v] is the first edge of v that may still lead to
+ the termination, so every edge is skipped at most once per phase. */
+FlowNetwork::Flow FlowNetwork::PushBlockingFlow() {
+  const Flow INF = std::numeric_limits<Flow>::max();
+  Flow blocking_flow = 0;
+  std::vector<size_t> path;
+  Vertex vertex = source_;
+  while (true) {
+    if (vertex == termination_) {
+      Flow delta = INF;
+      for (size_t index : path) {
+        delta = std::min(delta, index_edge_[index].ResidualCapacity());
+      }
+      size_t first_saturated = path.size();
+      for (size_t i = 0; i < path.size(); ++i) {
+        index_edge_[path[i]].flow += delta;
+        GetBackEdge(path[i]).flow -= delta;
+        if (first_saturated == path.size() && index_edge_[path[i]].ResidualCapacity() == 0) {
+          first_saturated = i;
+        }
+      }
+      blocking_flow += delta;
+      path.resize(first_saturated);
+      vertex = path.empty() ? source_ : index_edge_[path.back()].to;
+      continue;
+    }
+    const std::vector<size_t> &incident_edges = adj_list_[vertex];
+    size_t &arc = current_arc_[vertex];
+    while (arc < incident_edges.size()) {
+      const FlowEdge &flow_edge = index_edge_[incident_edges[arc]];
+      if (flow_edge.ResidualCapacity() > 0 && level_[flow_edge.to] == level_[vertex] + 1) {
+        break;
+      }
+      ++arc;
+    }
+    if (arc < incident_edges.size()) {
+      path.push_back(incident_edges[arc]);
+      vertex = index_edge_[incident_edges[arc]].to;
+    } else if (vertex == source_) {
+      break;
+    } else {
+      path.pop_back();
+      vertex = path.empty() ? source_ : index_edge_[path.back()].to;
+      ++current_arc_[vertex];
+    }
+  }
+  return blocking_flow;
+}
+
+////////////////////////////// Push-Relabel Algorithm //////////////////////////////
+
+/* Highest-label push-relabel. Only the first phase is run: a vertex whose height reaches vertex_count_
+ can no longer send flow to the termination, so its excess is left in place. This is enough for the
+ value of the max flow and for the min cut. */
+FlowNetwork::Flow FlowNetwork::GetMaxFlow_PushRelabel() {
+  excess_.assign(vertex_count_, 0);
+  GlobalRelabel();
+  for (size_t index : adj_list_[source_]) {
+    FlowEdge &flow_edge = index_edge_[index];
+    Flow delta = flow_edge.ResidualCapacity();
+    if (delta > 0) {
+      flow_edge.flow += delta;
+      GetBackEdge(index).flow -= delta;
+      excess_[source_] -= delta;
+      excess_[flow_edge.to] += delta;
+      Activate(flow_edge.to);
+    }
+  }
+
+  size_t relabels_before_global = vertex_count_;
+  while (true) {
+    while (highest_active_ > 0 && active_by_height_[highest_active_].empty()) {
+      --highest_active_;
+    }
+    if (active_by_height_[highest_active_].empty()) {
+      break;
+    }
+    Vertex vertex = active_by_height_[highest_active_].back();
+    active_by_height_[highest_active_].pop_back();
+    if (height_[vertex] != highest_active_ || excess_[vertex] == 0) {
+      continue;
+    }
+    const size_t old_height = height_[vertex];
+    Discharge(vertex);
+    if (height_[vertex] != old_height && --relabels_before_global == 0) {
+      GlobalRelabel();
+      relabels_before_global = vertex_count_;
+    }
+  }
+  return excess_[termination_];
+}
+
+std::vector<size_t> FlowNetwork::GetDistancesToTermination() const {
+  std::vector<size_t> distance(vertex_count_, vertex_count_);
+  std::vector<Vertex> queue;
+  queue.reserve(vertex_count_);
+  queue.push_back(termination_);
+  distance[termination_] = 0;
+  for (size_t head = 0; head < queue.size(); ++head) {
+    Vertex vertex = queue[head];
+    for (size_t index : adj_list_[vertex]) {
+      Vertex adj_vertex = index_edge_[index].to;
+      if (distance[adj_vertex] == vertex_count_ && index_edge_[index ^ 1].ResidualCapacity() > 0) {
+        distance[adj_vertex] = distance[vertex] + 1;
+        queue.push_back(adj_vertex);
+      }
+    }
+  }
+  return distance;
+}
+
+void FlowNetwork::GlobalRelabel() {
+  height_ = GetDistancesToTermination();
+  height_[source_] = vertex_count_;
+  height_count_.assign(vertex_count_ + 1, 0);
+  active_by_height_.assign(vertex_count_, {});
+  current_arc_.assign(vertex_count_, 0);
+  highest_active_ = 0;
+  for (Vertex vertex = 0; vertex < vertex_count_; ++vertex) {
+    ++height_count_[height_[vertex]];
+    if (excess_[vertex] > 0) {
+      Activate(vertex);
+    }
+  }
+}
+
+void FlowNetwork::Activate(const Vertex &vertex) {
+  if (vertex == source_ || vertex == termination_ || height_[vertex] >= vertex_count_) {
+    return;
+  }
+  active_by_height_[height_[vertex]].push_back(vertex);
+  highest_active_ = std::max(highest_active_, height_[vertex]);
+}
+
+void FlowNetwork::Push(size_t index) {
+  FlowEdge &flow_edge = index_edge_[index];
+  Flow delta = std::min(excess_[flow_edge.from], flow_edge.ResidualCapacity());
+  flow_edge.flow += delta;
+  GetBackEdge(index).flow -= delta;
+  excess_[flow_edge.from] -= delta;
+  if (excess_[flow_edge.to] == 0) {
+    excess_[flow_edge.to] += delta;
+    Activate(flow_edge.to);
+  } else {
+    excess_[flow_edge.to] += delta;
+  }
+}
+
+// If the vertex was the only one at its height, nothing above this gap can reach the termination.
+void FlowNetwork::Relabel(const Vertex &vertex) {
+  const size_t old_height = height_[vertex];
+  if (height_count_[old_height] == 1) {
+    for (Vertex other = 0; other < vertex_count_; ++other) {
+      if (height_[other] >= old_height && height_[other] < vertex_count_) {
+        --height_count_[height_[other]];
+        height_[other] = vertex_count_;
+        ++height_count_[vertex_count_];
+      }
+    }
+    return;
+  }
+  size_t new_height = vertex_count_;
+  for (size_t index : adj_list_[vertex]) {
+    const FlowEdge &flow_edge = index_edge_[index];
+    if (flow_edge.ResidualCapacity() > 0) {
+      new_height = std::min(new_height, height_[flow_edge.to] + 1);
+    }
+  }
+  --height_count_[old_height];
+  height_[vertex] = new_height;
+  ++height_count_[new_height];
+  current_arc_[vertex] = 0;
+}
+
+void FlowNetwork::Discharge(const Vertex &vertex) {
+  const std::vector<size_t> &incident_edges = adj_list_[vertex];
+  while (excess_[vertex] > 0) {
+    if (current_arc_[vertex] == incident_edges.size()) {
+      Relabel(vertex);
+      if (height_[vertex] >= vertex_count_) {
+        return;
+      }
+      continue;
+    }
+    size_t index = incident_edges[current_arc_[vertex]];
+    const FlowEdge &flow_edge = index_edge_[index];
+    if (flow_edge.ResidualCapacity() > 0 && height_[vertex] == height_[flow_edge.to] + 1) {
+      Push(index);
+    } else {
+      ++current_arc_[vertex];
+    }
+  }
+}
+
+////////////////////////////// Parallel Push-Relabel //////////////////////////////
+
+/* Lock-free push-relabel: every vertex is discharged only by its owner thread (vertex % threads_count),
+ residual capacities and excesses are atomics, and a push only ever lowers values that the pushing
+ thread owns. Threads run until their vertices are idle or the relabel budget is spent; then the flow is
+ written back to index_edge_ and heights are recomputed by a global relabel before the next round. */
+struct FlowNetwork::ConcurrentPreflow {
+  std::unique_ptr<std::atomic<Flow>[]> residual;
+  std::unique_ptr<std::atomic<Flow>[]> excess;
+  std::unique_ptr<std::atomic<size_t>[]> height;
+  std::atomic<int64_t> relabels_left;
+
+  ConcurrentPreflow(size_t vertex_count, size_t edges_count)
+      : residual(new std::atomic<Flow>[edges_count]),
+        excess(new std::atomic<Flow>[vertex_count]),
+        height(new std::atomic<size_t>[vertex_count]),
+        relabels_left(0) {}
+};
+
+FlowNetwork::Flow FlowNetwork::GetMaxFlow_ParallelPushRelabel(size_t threads_count) {
+  threads_count = std::max<size_t>(threads_count, 1);
+  const size_t edges_count = index_edge_.size();
+  ConcurrentPreflow preflow(vertex_count_, edges_count);
+  for (Vertex vertex = 0; vertex < vertex_count_; ++vertex) {
+    preflow.excess[vertex] = 0;
+  }
+  for (size_t index : adj_list_[source_]) {
+    FlowEdge &flow_edge = index_edge_[index];
+    Flow delta = flow_edge.ResidualCapacity();
+    flow_edge.flow += delta;
+    GetBackEdge(index).flow -= delta;
+    preflow.excess[flow_edge.to] += delta;
+  }
+  for (size_t index = 0; index < edges_count; ++index) {
+    preflow.residual[index] = index_edge_[index].ResidualCapacity();
+  }
+
+  while (true) {
+    for (size_t index = 0; index < edges_count; ++index) {
+      index_edge_[index].flow = index_edge_[index].capacity - preflow.residual[index];
+    }
+    std::vector<size_t> distance = GetDistancesToTermination();
+    distance[source_] = vertex_count_;
+    bool has_active = false;
+    for (Vertex vertex = 0; vertex < vertex_count_; ++vertex) {
+      preflow.height[vertex] = distance[vertex];
+      has_active |= (vertex != source_ && vertex != termination_ && distance[vertex] < vertex_count_ &&
+                     preflow.excess[vertex] > 0);
+    }
+    if (!has_active) {
+      break;
+    }
+    preflow.relabels_left = vertex_count_;
+    std::vector<std::thread> threads;
+    for (size_t thread_id = 1; thread_id < threads_count; ++thread_id) {
+      threads.emplace_back(&FlowNetwork::DischargeConcurrently, this, std::ref(preflow), thread_id, threads_count);
+    }
+    DischargeConcurrently(preflow, 0, threads_count);
+    for (auto &thread : threads) {
+      thread.join();
+    }
+  }
+  return preflow.excess[termination_];
+}
+
+void FlowNetwork::DischargeConcurrently(ConcurrentPreflow &preflow, size_t thread_id, size_t threads_count) const {
+  bool has_work = true;
+  while (has_work && preflow.relabels_left > 0) {
+    has_work = false;
+    for (Vertex vertex = thread_id; vertex < vertex_count_; vertex += threads_count) {
+      if (vertex == source_ || vertex == termination_) {
+        continue;
+      }
+      while (preflow.excess[vertex] > 0 && preflow.height[vertex] < vertex_count_) {
+        has_work = true;
+        size_t lowest_index = 0;
+        size_t lowest_height = vertex_count_;
+        for (size_t index : adj_list_[vertex]) {
+          size_t adj_height = preflow.height[index_edge_[index].to];
+          if (preflow.residual[index] > 0 && adj_height < lowest_height) {
+            lowest_height = adj_height;
+            lowest_index = index;
+          }
+        }
+        if (lowest_height >= preflow.height[vertex]) {
+          preflow.height[vertex] = std::min(lowest_height + 1, vertex_count_);
+          if (--preflow.relabels_left <= 0) {
+            return;
+          }
+          continue;
+        }
+        Flow delta = std::min<Flow>(preflow.excess[vertex], preflow.residual[lowest_index]);
+        preflow.residual[lowest_index] -= delta;
+        preflow.residual[lowest_index ^ 1] += delta;
+        preflow.excess[vertex] -= delta;
+        preflow.excess[index_edge_[lowest_index].to] += delta;
+      }
+    }
+  }
+}
+
+// Vertices that can not reach the termination in the residual network.
+std::vector<FlowNetwork::Vertex> FlowNetwork::GetMinCutSourceSide() const {
+  std::vector<size_t> distance = GetDistancesToTermination();
+  std::vector<Vertex> source_side;
+  for (Vertex vertex = 0; vertex < vertex_count_; ++vertex) {
+    if (distance[vertex] == vertex_count_) {
+      source_side.push_back(vertex);
+    }
+  }
+  return source_side;
+}
+
+////////////////////////////// Min Cost Flow //////////////////////////////
+
+/* Successive shortest paths. Potentials keep every reduced cost cost + potential[from] - potential[to]
+ of a residual edge non-negative, so each cheapest path is found with Dijkstra. */
+std::pair<FlowNetwork::Flow, FlowNetwork::Cost> FlowNetwork::GetMinCostMaxFlow(const Flow &flow_limit) {
+  std::vector<Cost> potential = GetInitialPotentials();
+  std::vector<size_t> parent_edge(vertex_count_);
+  Flow total_flow = 0;
+  Cost total_cost = 0;
+  while (total_flow < flow_limit && FindCheapestPath(potential, parent_edge)) {
+    Flow delta = flow_limit - total_flow;
+    for (Vertex vertex = termination_; vertex != source_; vertex = index_edge_[parent_edge[vertex]].from) {
+      delta = std::min(delta, index_edge_[parent_edge[vertex]].ResidualCapacity());
+    }
+    for (Vertex vertex = termination_; vertex != source_; vertex = index_edge_[parent_edge[vertex]].from) {
+      index_edge_[parent_edge[vertex]].flow += delta;
+      GetBackEdge(parent_edge[vertex]).flow -= delta;
+      total_cost += delta * index_edge_[parent_edge[vertex]].cost;
+    }
+    total_flow += delta;
+  }
+  return {total_flow, total_cost};
+}
+
+// Ford-Bellman distances from the source, needed only when some residual edge has a negative cost.
+std::vector<FlowNetwork::Cost> FlowNetwork::GetInitialPotentials() const {
+  const Cost INF = std::numeric_limits<Cost>::max();
+  std::vector<Cost> potential(vertex_count_, 0);
+  bool has_negative_cost = false;
+  for (const auto &flow_edge : index_edge_) {
+    has_negative_cost |= (flow_edge.ResidualCapacity() > 0 && flow_edge.cost < 0);
+  }
+  if (!has_negative_cost) {
+    return potential;
+  }
+  potential.assign(vertex_count_, INF);
+  potential[source_] = 0;
+  for (size_t iteration = 0; iteration + 1 < vertex_count_; ++iteration) {
+    bool relaxed = false;
+    for (const auto &flow_edge : index_edge_) {
+      if (flow_edge.ResidualCapacity() > 0 && potential[flow_edge.from] != INF &&
+          potential[flow_edge.from] + flow_edge.cost < potential[flow_edge.to]) {
+        potential[flow_edge.to] = potential[flow_edge.from] + flow_edge.cost;
+        relaxed = true;
+      }
+    }
+    if (!relaxed) {
+      break;
+    }
+  }
+  for (auto &value : potential) {
+    if (value == INF) {
+      value = 0;
+    }
+  }
+  return potential;
+}
+
+bool FlowNetwork::FindCheapestPath(std::vector<Cost> &potential, std::vector<size_t> &parent_edge) const {
+  const Cost INF = std::numeric_limits<Cost>::max();
+  typedef std::pair<Cost, Vertex> Distance_Vertex;
+  std::priority_queue<Distance_Vertex, std::vector<Distance_Vertex>, std::greater<>> priority_queue;
+  std::vector<Cost> distance(vertex_count_, INF);
+  distance[source_] = 0;
+  priority_queue.push({0, source_});
+  while (!priority_queue.empty()) {
+    auto[vertex_distance, vertex] = priority_queue.top();
+    priority_queue.pop();
+    if (vertex_distance != distance[vertex]) {
+      continue;
+    }
+    for (size_t index : adj_list_[vertex]) {
+      const FlowEdge &flow_edge = index_edge_[index];
+      if (flow_edge.ResidualCapacity() == 0) {
+        continue;
+      }
+      Cost reduced_cost = flow_edge.cost + potential[vertex] - potential[flow_edge.to];
+      if (distance[vertex] + reduced_cost < distance[flow_edge.to]) {
+        distance[flow_edge.to] = distance[vertex] + reduced_cost;
+        parent_edge[flow_edge.to] = index;
+        priority_queue.push({distance[flow_edge.to], flow_edge.to});
+      }
+    }
+  }
+  if (distance[termination_] == INF) {
+    return false;
+  }
+  for (Vertex vertex = 0; vertex < vertex_count_; ++vertex) {
+    potential[vertex] += std::min(distance[vertex], distance[termination_]);
+  }
+  return true;
+}
+
 ////////////////////////////// struct FlowEdge //////////////////////////////
 
-FlowNetwork::FlowEdge::FlowEdge(const Vertex &from, const Vertex &to, const Flow &capacity)
+FlowNetwork::FlowEdge::FlowEdge(const Vertex &from, const Vertex &to, const Flow &capacity, const Cost &cost)
     : from(from),
       to(to),
       capacity(capacity),
-      flow(0) {}
+      flow(0),
+      cost(cost) {}
 
 FlowNetwork::Flow FlowNetwork::FlowEdge::ResidualCapacity() const {
   return capacity - flow;
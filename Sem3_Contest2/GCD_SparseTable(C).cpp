@@ -22,13 +22,43 @@ Input	   Output
 #include <vector>
 #include <algorithm>
 #include <memory>
+#include <utility>
+#include <unordered_map>
+#include <cstdint>
+#include <type_traits>
 
+// Absolute value of an integer in its unsigned type, correct for the minimum of a signed type as well.
+template<typename T>
+typename std::make_unsigned<T>::type UnsignedAbs(T value, std::true_type) {
+  typedef typename std::make_unsigned<T>::type Unsigned;
+  return (value < 0) ? Unsigned(0) - static_cast<Unsigned>(value) : static_cast<Unsigned>(value);
+}
+
+template<typename T>
+T UnsignedAbs(T value, std::false_type) {
+  return value;
+}
+
+// Binary (Stein's) gcd: common factors of two are counted by ctz, then the odd parts are reduced by subtraction.
+// min/max instead of a swap keep the loop free of unpredictable branches. Signed values are taken by absolute value,
+// so the result is non-negative like std::gcd.
 template <typename T>
-T gcd(const T &lhs, const T &rhs){
-  if (rhs == 0) {
-    return lhs;
+T gcd(T lhs_value, T rhs_value) {
+  typedef typename std::make_unsigned<T>::type Unsigned;
+  Unsigned lhs = UnsignedAbs(lhs_value, std::is_signed<T>());
+  Unsigned rhs = UnsignedAbs(rhs_value, std::is_signed<T>());
+  if (lhs == 0 || rhs == 0) {
+    return static_cast<T>(lhs | rhs);
   }
-  return gcd(rhs, lhs % rhs);
+  const int shift = __builtin_ctzll(lhs | rhs);
+  rhs >>= __builtin_ctzll(rhs);
+  do {
+    lhs >>= __builtin_ctzll(lhs);
+    const Unsigned smaller = std::min(lhs, rhs);
+    lhs = std::max(lhs, rhs) - smaller;
+    rhs = smaller;
+  } while (lhs != 0);
+  return static_cast<T>(rhs << shift);
 }
 
 template<typename T>
@@ -41,29 +71,103 @@ struct GCD {
 template<typename T, typename Function>
 class SparseTable {
  private:
-  std::vector<std::vector<T>> sparse_table_;
+  size_t size_;
+  // Level k (ranges of length 2^k) occupies [k * size_, k * size_ + size_ - 2^k + 1) of one allocation.
+  std::vector<T> sparse_table_;
   Function function_;
-  std::vector<size_t> log_2_;
+
+  static size_t Log_2(size_t value) {
+    return 63 - __builtin_clzll(value);
+  }
 
  public:
-  explicit SparseTable(const std::vector<T> &values) : log_2_(values.size(), 0) {
-    const size_t table_size = values.size();
-    for (size_t i = 2; i < table_size; ++i) {
-      log_2_[i] = log_2_[i / 2] + 1;
+  explicit SparseTable(const std::vector<T> &values)
+      : size_(values.size()), sparse_table_(values.empty() ? 0 : (Log_2(values.size()) + 1) * values.size()) {
+    std::copy(values.begin(), values.end(), sparse_table_.begin());
+    for (size_t level = 1; (size_t(1) << level) <= size_; ++level) {
+      const T *previous_level = sparse_table_.data() + (level - 1) * size_;
+      T *current_level = sparse_table_.data() + level * size_;
+      const size_t half = size_t(1) << (level - 1);
+      for (size_t i = 0; i + 2 * half <= size_; ++i) {
+        current_level[i] = function_(previous_level[i], previous_level[i + half]);
+      }
     }
-    sparse_table_.push_back(values);
-    for (size_t delta = 2; delta <= table_size; delta *= 2) {
-      std::vector<T> next_level_values(table_size - delta + 1);
-      for (size_t i = 0; i < next_level_values.size(); ++i) {
-        next_level_values[i] = function_(sparse_table_.back()[i], sparse_table_.back()[i + delta / 2]);
+  }
+
+  T Query(size_t left, size_t right) const {
+    const size_t level = Log_2(right - left + 1);
+    const T *values = sparse_table_.data() + level * size_;
+    return function_(values[left], values[right - (size_t(1) << level) + 1]);
+  }
+
+  // Answers ranges in the given order, prefetching the two cells of the range kPrefetchDistance steps ahead.
+  std::vector<T> Query(const std::vector<std::pair<size_t, size_t>> &ranges) const {
+    static constexpr size_t kPrefetchDistance = 16;
+    std::vector<T> answers(ranges.size());
+    for (size_t i = 0; i < ranges.size(); ++i) {
+      if (i + kPrefetchDistance < ranges.size()) {
+        const auto &range = ranges[i + kPrefetchDistance];
+        const size_t level = Log_2(range.second - range.first + 1);
+        const T *values = sparse_table_.data() + level * size_;
+        __builtin_prefetch(values + range.first);
+        __builtin_prefetch(values + range.second - (size_t(1) << level) + 1);
+      }
+      answers[i] = Query(ranges[i].first, ranges[i].second);
+    }
+    return answers;
+  }
+};
+
+/* For a fixed right end the gcd of values[left..right] only changes where it drops to a divisor, so there are at most
+ log(max value) + 1 runs of left ends with equal gcd. They are kept for every right end: a run stores its gcd and its
+ smallest left end, runs go from left = right outwards. Range gcd scans the runs of right, the number of subarrays
+ with a given gcd is counted while building. */
+template<typename T>
+class GCDSubarrays {
+ private:
+  struct Run {
+    T gcd_;
+    size_t first_left_;
+  };
+
+  std::vector<Run> runs_;
+  std::vector<size_t> runs_begin_;
+  std::unordered_map<T, uint64_t> subarrays_count_;
+
+ public:
+  explicit GCDSubarrays(const std::vector<T> &values) : runs_begin_(1, 0) {
+    for (size_t right = 0; right < values.size(); ++right) {
+      const size_t previous_begin = runs_begin_.back();
+      runs_.push_back({values[right], right});
+      for (size_t idx = (right > 0) ? runs_begin_[right - 1] : 0; idx < previous_begin; ++idx) {
+        const T run_gcd = gcd(runs_[idx].gcd_, values[right]);
+        if (run_gcd == runs_.back().gcd_) {
+          runs_.back().first_left_ = runs_[idx].first_left_;
+        } else {
+          runs_.push_back({run_gcd, runs_[idx].first_left_});
+        }
+      }
+      runs_begin_.push_back(runs_.size());
+      size_t last_left = right + 1;
+      for (size_t idx = previous_begin; idx < runs_.size(); ++idx) {
+        subarrays_count_[runs_[idx].gcd_] += last_left - runs_[idx].first_left_;
+        last_left = runs_[idx].first_left_;
       }
-      sparse_table_.push_back(next_level_values);
     }
   }
 
   T Query(size_t left, size_t right) const {
-    size_t log_2 = log_2_[right - left];
-    return function_(sparse_table_[log_2][left], sparse_table_[log_2][right - (1u << log_2) + 1]);
+    size_t idx = runs_begin_[right];
+    while (runs_[idx].first_left_ > left) {
+      ++idx;
+    }
+    return runs_[idx].gcd_;
+  }
+
+  // Number of subarrays of the whole array whose gcd equals value.
+  uint64_t CountSubarrays(const T &value) const {
+    auto count = subarrays_count_.find(value);
+    return (count == subarrays_count_.end()) ? 0 : count->second;
   }
 };
 
@@ -77,11 +181,14 @@ int main() {
   SparseTable<size_t, GCD<size_t>> sparse_table(values);
   size_t queries_num;
   std::cin >> queries_num;
+  std::vector<std::pair<size_t, size_t>> ranges(queries_num);
   for (size_t i = 0; i < queries_num; ++i) {
     size_t left, right;
     std::cin >> left >> right;
-    auto query = sparse_table.Query(left - 1, right - 1);
-    std::cout << query << std::endl;
+    ranges[i] = {left - 1, right - 1};
+  }
+  for (size_t answer : sparse_table.Query(ranges)) {
+    std::cout << answer << std::endl;
   }
 
   return 0;
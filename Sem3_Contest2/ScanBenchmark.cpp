@@ -0,0 +1,151 @@
+/*
+Benchmark of the in-place inclusive scan used by B.cpp: the sequential scan against the reduce-then-scan split between
+ threads. For every array size and thread count prints the best time of several runs and the throughput in GB/s of
+ scanned data (size * sizeof(value) bytes per scan).
+
+Usage: ScanBenchmark [max_threads] [max_size_log]
+ max_threads defaults to std::thread::hardware_concurrency(), max_size_log to 28 (2^28 32-bit values, 1 GB).
+ */
+
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <algorithm>
+#include <numeric>
+#include <string>
+#include <thread>
+#include <chrono>
+#include <cstring>
+#include <cstdint>
+#include <cstdlib>
+#include <type_traits>
+#include <functional>
+
+// Splits [0, count) into threads_count contiguous chunks and runs task(chunk, begin, end) for each in its own thread.
+template<typename Task>
+void ParallelFor(size_t count, size_t threads_count, const Task &task) {
+  threads_count = std::max<size_t>(1, std::min(threads_count, count));
+  const size_t chunk_size = (count + threads_count - 1) / threads_count;
+  std::vector<std::thread> threads;
+  for (size_t chunk = 1; chunk < threads_count; ++chunk) {
+    threads.emplace_back(task, chunk, std::min(count, chunk * chunk_size), std::min(count, (chunk + 1) * chunk_size));
+  }
+  task(0, 0, std::min(count, chunk_size));
+  for (auto &thread : threads) {
+    thread.join();
+  }
+}
+
+// The two scans below are the ones of B.cpp.
+template<typename T, typename Operation>
+T SequentialScan(T *values, size_t size, T carry, const Operation &operation) {
+  for (size_t i = 0; i < size; ++i) {
+    carry = operation(carry, values[i]);
+    values[i] = carry;
+  }
+  return carry;
+}
+
+template<typename T, typename std::enable_if<std::is_integral<T>::value && sizeof(T) == 4>::type * = nullptr>
+T SequentialScan(T *values, size_t size, T carry, const std::plus<T> &) {
+  typedef T Vector __attribute__((vector_size(16)));
+  typedef uint32_t Mask __attribute__((vector_size(16)));
+  static constexpr size_t kLanes = sizeof(Vector) / sizeof(T);
+  const Vector zero = {0, 0, 0, 0};
+  Vector carries = {carry, carry, carry, carry};
+  size_t i = 0;
+  for (; i + kLanes <= size; i += kLanes) {
+    Vector sums;
+    std::memcpy(&sums, values + i, sizeof(Vector));
+    sums += __builtin_shuffle(sums, zero, Mask{4, 0, 1, 2});
+    sums += __builtin_shuffle(sums, zero, Mask{4, 5, 0, 1});
+    sums += carries;
+    std::memcpy(values + i, &sums, sizeof(Vector));
+    carries = __builtin_shuffle(sums, Mask{3, 3, 3, 3});
+  }
+  carry = carries[0];
+  for (; i < size; ++i) {
+    carry += values[i];
+    values[i] = carry;
+  }
+  return carry;
+}
+
+/* Reduce-then-scan over threads_count chunks: chunk totals are folded in parallel and scanned, then every chunk is
+ scanned starting from the total of the chunks before it. */
+template<typename T, typename Operation>
+void ParallelScan(T *values, size_t size, const Operation &operation, size_t threads_count) {
+  if (size == 0) {
+    return;
+  }
+  threads_count = std::max<size_t>(1, std::min(threads_count, size));
+  if (threads_count == 1) {
+    SequentialScan(values + 1, size - 1, values[0], operation);
+    return;
+  }
+  std::vector<T> carries(threads_count);
+  ParallelFor(size, threads_count, [values, &carries, &operation](size_t chunk, size_t begin, size_t end) {
+    T total = values[begin];
+    for (size_t i = begin + 1; i < end; ++i) {
+      total = operation(total, values[i]);
+    }
+    carries[chunk] = total;
+  });
+  for (size_t chunk = 1; chunk < threads_count; ++chunk) {
+    carries[chunk] = operation(carries[chunk - 1], carries[chunk]);
+  }
+  ParallelFor(size, threads_count, [values, &carries, &operation](size_t chunk, size_t begin, size_t end) {
+    if (chunk == 0) {
+      SequentialScan(values + 1, end - 1, values[0], operation);
+    } else {
+      SequentialScan(values + begin, end - begin, carries[chunk - 1], operation);
+    }
+  });
+}
+
+// Best of runs_count scans of a fresh copy of source, in seconds; the result is checked against expected.
+double MeasureScan(const std::vector<uint32_t> &source, const std::vector<uint32_t> &expected, size_t threads_count,
+                   size_t runs_count) {
+  std::vector<uint32_t> values(source.size());
+  double best_time = 1e100;
+  for (size_t run = 0; run < runs_count; ++run) {
+    std::copy(source.begin(), source.end(), values.begin());
+    const auto start = std::chrono::steady_clock::now();
+    ParallelScan(values.data(), values.size(), std::plus<uint32_t>(), threads_count);
+    const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    best_time = std::min(best_time, elapsed.count());
+    if (values != expected) {
+      std::cerr << "wrong scan with " << threads_count << " threads\n";
+      std::exit(1);
+    }
+  }
+  return best_time;
+}
+
+int main(int argc, char **argv) {
+  const size_t max_threads = (argc > 1) ? std::strtoul(argv[1], nullptr, 10)
+                                        : std::max(1u, std::thread::hardware_concurrency());
+  const size_t max_size_log = (argc > 2) ? std::strtoul(argv[2], nullptr, 10) : 28;
+  std::cout << std::setw(10) << "size" << std::setw(10) << "threads" << std::setw(12) << "ms" << std::setw(10)
+            << "GB/s" << '\n' << std::fixed;
+  for (size_t size_log = 16; size_log <= max_size_log; size_log += 4) {
+    const size_t size = size_t(1) << size_log;
+    std::vector<uint32_t> source(size);
+    uint32_t state = 0;
+    for (auto &value : source) {
+      state = state * 1103515245u + 12345u;
+      value = state >> 8u;
+    }
+    std::vector<uint32_t> expected = source;
+    std::partial_sum(expected.begin(), expected.end(), expected.begin());
+    const size_t runs_count = std::max<size_t>(3, (size_t(1) << 26) / size);
+    for (size_t threads_count = 1; threads_count <= max_threads; threads_count *= 2) {
+      const double seconds = MeasureScan(source, expected, threads_count, runs_count);
+      std::cout << std::setw(10) << ("2^" + std::to_string(size_log)) << std::setw(10) << threads_count
+                << std::setw(12) << std::setprecision(3) << seconds * 1e3 << std::setw(10) << std::setprecision(2)
+                << size * sizeof(uint32_t) / seconds / 1e9 << '\n';
+    }
+  }
+
+  return 0;
+}
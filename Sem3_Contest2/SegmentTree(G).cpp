@@ -34,178 +34,762 @@ u 5 377
 #include <iostream>
 #include <vector>
 #include <algorithm>
-#include <memory>
 #include <limits>
+#include <type_traits>
+#include <utility>
 
-////////////////////////////// class SegmentTree (Declaration) //////////////////////////////
+////////////////////////////// Monoids //////////////////////////////
 
 template<typename T>
-class SegmentTree {
- private:
-  struct Node {
-    T min_;
-    T sum_;
-    static constexpr T min_pending_value_ = std::numeric_limits<T>::max();
-    static constexpr T sum_pending_value_ = T(0);
+struct Sum {
+  typedef T Type;
 
-    Node();
+  static Type Identity() {
+    return T(0);
+  }
 
-    Node(const Node &first, const Node &second);
+  static Type Combine(const Type &lhs, const Type &rhs) {
+    return lhs + rhs;
+  }
+};
 
-    Node &operator=(const T &value);
-  };
+template<typename T>
+struct Min {
+  typedef T Type;
+
+  static Type Identity() {
+    return std::numeric_limits<T>::max();
+  }
+
+  static Type Combine(const Type &lhs, const Type &rhs) {
+    return std::min(lhs, rhs);
+  }
+};
+
+template<typename T>
+struct Max {
+  typedef T Type;
+
+  static Type Identity() {
+    return std::numeric_limits<T>::lowest();
+  }
+
+  static Type Combine(const Type &lhs, const Type &rhs) {
+    return std::max(lhs, rhs);
+  }
+};
+
+struct NoAction {
+  typedef bool Type;
+
+  static Type Identity() {
+    return false;
+  }
+
+  static Type Compose(const Type &, const Type &) {
+    return false;
+  }
+
+  template<typename Value>
+  static Value Apply(const Type &, const Value &value, size_t) {
+    return value;
+  }
+};
+
+// Adds a constant to every element of the segment.
+template<typename ValueMonoid>
+struct RangeAdd;
+
+template<typename T>
+struct RangeAdd<Sum<T>> {
+  typedef T Type;
+
+  static Type Identity() {
+    return T(0);
+  }
+
+  static Type Compose(const Type &outer, const Type &inner) {
+    return outer + inner;
+  }
+
+  static T Apply(const Type &action, const T &value, size_t length) {
+    return value + action * static_cast<T>(length);
+  }
+};
+
+template<typename T>
+struct RangeAdd<Min<T>> {
+  typedef T Type;
+
+  static Type Identity() {
+    return T(0);
+  }
+
+  static Type Compose(const Type &outer, const Type &inner) {
+    return outer + inner;
+  }
+
+  static T Apply(const Type &action, const T &value, size_t) {
+    return value + action;
+  }
+};
+
+template<typename T>
+struct RangeAdd<Max<T>> : RangeAdd<Min<T>> {};
+
+// Assigns a constant to every element of the segment.
+template<typename T>
+struct Assignment {
+  bool is_set_;
+  T value_;
+};
+
+template<typename ValueMonoid>
+struct RangeAssign {
+  typedef typename ValueMonoid::Type T;
+  typedef Assignment<T> Type;
+
+  static Type Identity() {
+    return {false, T()};
+  }
+
+  static Type Compose(const Type &outer, const Type &inner) {
+    return outer.is_set_ ? outer : inner;
+  }
+
+  static T Apply(const Type &action, const T &value, size_t length) {
+    if (!action.is_set_) {
+      return value;
+    }
+    // Node segments always have power of two length, so doubling covers them exactly.
+    T result = action.value_;
+    for (size_t power = 1; power < length; power *= 2) {
+      result = ValueMonoid::Combine(result, result);
+    }
+    return result;
+  }
+};
+
+template<typename T>
+struct RangeAssign<Sum<T>> : RangeAssign<Min<T>> {
+  typedef Assignment<T> Type;
+
+  static T Apply(const Type &action, const T &value, size_t length) {
+    return action.is_set_ ? action.value_ * static_cast<T>(length) : value;
+  }
+};
+
+////////////////////////////// Batch queries //////////////////////////////
+
+// Buckets queries by key(query) < key_limit, so that consecutive ranges walk neighbouring leaves. Keeps positions.
+template<typename Query, typename Key>
+std::vector<std::pair<Query, size_t>> SortQueries(const std::vector<Query> &queries, size_t key_limit, const Key &key) {
+  const size_t buckets_count = queries.size() + 1;
+  std::vector<size_t> bucket(queries.size());
+  std::vector<size_t> bucket_begin(buckets_count + 1, 0);
+  for (size_t idx = 0; idx < queries.size(); ++idx) {
+    bucket[idx] = key(queries[idx]) * buckets_count / std::max<size_t>(1, key_limit);
+    ++bucket_begin[bucket[idx] + 1];
+  }
+  for (size_t idx = 0; idx < buckets_count; ++idx) {
+    bucket_begin[idx + 1] += bucket_begin[idx];
+  }
+  std::vector<size_t> order(queries.size());
+  for (size_t idx = 0; idx < queries.size(); ++idx) {
+    order[bucket_begin[bucket[idx]]++] = idx;
+  }
+  std::vector<std::pair<Query, size_t>> sorted;
+  sorted.reserve(queries.size());
+  for (size_t idx : order) {
+    sorted.emplace_back(queries[idx], idx);
+  }
+  return sorted;
+}
+
+// Writes answer_query(query) to answers[position], prefetching the query kPrefetchDistance steps ahead.
+template<typename Query, typename Answer, typename AnswerQuery, typename Prefetch>
+void AnswerSortedQueries(const std::vector<std::pair<Query, size_t>> &sorted, std::vector<Answer> &answers,
+                         const AnswerQuery &answer_query, const Prefetch &prefetch) {
+  static constexpr size_t kPrefetchDistance = 8;
+  for (size_t idx = 0; idx < sorted.size(); ++idx) {
+    if (idx + kPrefetchDistance < sorted.size()) {
+      prefetch(sorted[idx + kPrefetchDistance].first);
+    }
+    answers[sorted[idx].second] = answer_query(sorted[idx].first);
+  }
+}
+
+////////////////////////////// class SegmentTree (Declaration) //////////////////////////////
 
-  std::vector<Node> segment_tree_;
+/* Bottom-up segment tree with lazy propagation.
+ ValueMonoid:  Type, Identity(), Combine(lhs, rhs) - associative, not necessarily commutative.
+ ActionMonoid: Type, Identity(), Compose(outer, inner) - action "outer after inner",
+               Apply(action, value, length) - result of the action on a segment of length elements.
+ Enable:       selects the BlockSegmentTree specializations below, leave it defaulted. */
+template<typename ValueMonoid, typename ActionMonoid = NoAction, typename Enable = void>
+class SegmentTree {
+ public:
+  typedef typename ValueMonoid::Type Value;
+  typedef typename ActionMonoid::Type Action;
+
+ private:
+  size_t size_;
+  size_t height_;
+  std::vector<Value> segment_tree_;
+  std::vector<Action> pending_;
+
+  size_t FirstLeaf() const {
+    return size_t(1) << height_;
+  }
 
   static size_t Log_2(size_t value);
   static size_t PowerOfTwo_Ceil(size_t value);
 
-  T Parent(size_t idx) const {
+  size_t Parent(size_t idx) const {
     return idx / 2;
   }
 
-  T LeftChild(size_t idx) const {
+  size_t LeftChild(size_t idx) const {
     return idx * 2;
   }
 
-  T RightChild(size_t idx) const {
+  size_t RightChild(size_t idx) const {
     return idx * 2 + 1;
   }
 
-  struct Summary_ {
-    T operator()(const Node &lhs, const Node &rhs) const;
+  void ApplyToNode(size_t idx, const Action &action, size_t length);
+  void PushToChildren(size_t idx, size_t length);
+  void PushPath(size_t left, size_t right);
+  void UpdateNode(size_t idx);
+  Value QueryPushed(size_t left, size_t right) const;
 
-    T operator()(const T &value, const Node &node) const;
-  };
+ public:
+  explicit SegmentTree(const std::vector<Value> &values);
+
+  void Set(size_t idx, const Value &value);
+
+  Value Get(size_t idx);
+
+  void Update(size_t left, size_t right, const Action &action);
+
+  Value Query(size_t left, size_t right);
+
+  std::vector<Value> Query(const std::vector<std::pair<size_t, size_t>> &ranges);
+};
+
+////////////////////////////// class SegmentTree (Implementation) //////////////////////////////
 
-  struct Min_ {
-    T operator()(const Node &lhs, const Node &rhs) const;
+template<typename ValueMonoid, typename ActionMonoid, typename Enable>
+size_t SegmentTree<ValueMonoid, ActionMonoid, Enable>::Log_2(size_t value) {
+  size_t result = 0;
+  while (value >>= 1u) {
+    ++result;
+  }
+  return result;
+}
+
+template<typename ValueMonoid, typename ActionMonoid, typename Enable>
+size_t SegmentTree<ValueMonoid, ActionMonoid, Enable>::PowerOfTwo_Ceil(size_t value) {
+  return (value <= 1) ? 1 : size_t(1) << (Log_2(value - 1) + 1);
+}
+
+template<typename ValueMonoid, typename ActionMonoid, typename Enable>
+SegmentTree<ValueMonoid, ActionMonoid, Enable>::SegmentTree(const std::vector<Value> &values)
+    : size_(values.size()),
+      height_(Log_2(PowerOfTwo_Ceil(values.size()))),
+      segment_tree_(2 * PowerOfTwo_Ceil(values.size()), ValueMonoid::Identity()),
+      pending_(PowerOfTwo_Ceil(values.size()), ActionMonoid::Identity()) {
+  const size_t half_tree_size = FirstLeaf();
+  for (size_t idx = 0; idx < size_; ++idx) {
+    segment_tree_[idx + half_tree_size] = values[idx];
+  }
+  for (size_t idx = half_tree_size - 1; idx > 0; --idx) {
+    UpdateNode(idx);
+  }
+}
+
+template<typename ValueMonoid, typename ActionMonoid, typename Enable>
+void SegmentTree<ValueMonoid, ActionMonoid, Enable>::ApplyToNode(size_t idx, const Action &action, size_t length) {
+  segment_tree_[idx] = ActionMonoid::Apply(action, segment_tree_[idx], length);
+  if (idx < pending_.size()) {
+    pending_[idx] = ActionMonoid::Compose(action, pending_[idx]);
+  }
+}
+
+template<typename ValueMonoid, typename ActionMonoid, typename Enable>
+void SegmentTree<ValueMonoid, ActionMonoid, Enable>::PushToChildren(size_t idx, size_t length) {
+  ApplyToNode(LeftChild(idx), pending_[idx], length / 2);
+  ApplyToNode(RightChild(idx), pending_[idx], length / 2);
+  pending_[idx] = ActionMonoid::Identity();
+}
+
+// Pushes pending actions down to the borders of the half-open leaf range [left, right).
+template<typename ValueMonoid, typename ActionMonoid, typename Enable>
+void SegmentTree<ValueMonoid, ActionMonoid, Enable>::PushPath(size_t left, size_t right) {
+  for (size_t level = height_; level > 0; --level) {
+    if (((left >> level) << level) != left) {
+      PushToChildren(left >> level, size_t(1) << level);
+    }
+    if (((right >> level) << level) != right) {
+      PushToChildren((right - 1) >> level, size_t(1) << level);
+    }
+  }
+}
 
-    T operator()(const T &value, const Node &node) const;
+template<typename ValueMonoid, typename ActionMonoid, typename Enable>
+void SegmentTree<ValueMonoid, ActionMonoid, Enable>::UpdateNode(size_t idx) {
+  segment_tree_[idx] = ValueMonoid::Combine(segment_tree_[LeftChild(idx)], segment_tree_[RightChild(idx)]);
+}
+
+template<typename ValueMonoid, typename ActionMonoid, typename Enable>
+void SegmentTree<ValueMonoid, ActionMonoid, Enable>::Set(size_t idx, const Value &value) {
+  idx += FirstLeaf();
+  PushPath(idx, idx + 1);
+  segment_tree_[idx] = value;
+  while ((idx = Parent(idx)) > 0) {
+    UpdateNode(idx);
+  }
+}
+
+template<typename ValueMonoid, typename ActionMonoid, typename Enable>
+typename SegmentTree<ValueMonoid, ActionMonoid, Enable>::Value
+SegmentTree<ValueMonoid, ActionMonoid, Enable>::Get(size_t idx) {
+  idx += FirstLeaf();
+  PushPath(idx, idx + 1);
+  return segment_tree_[idx];
+}
+
+template<typename ValueMonoid, typename ActionMonoid, typename Enable>
+void SegmentTree<ValueMonoid, ActionMonoid, Enable>::Update(size_t left, size_t right, const Action &action) {
+  const size_t half_tree_size = FirstLeaf();
+  left += half_tree_size;
+  right += half_tree_size + 1;
+  PushPath(left, right);
+  for (size_t lhs = left, rhs = right, length = 1; lhs < rhs; lhs = Parent(lhs), rhs = Parent(rhs), length *= 2) {
+    if (lhs & 1u) {
+      ApplyToNode(lhs++, action, length);
+    }
+    if (rhs & 1u) {
+      ApplyToNode(--rhs, action, length);
+    }
+  }
+  for (size_t level = 1; level <= height_; ++level) {
+    if (((left >> level) << level) != left) {
+      UpdateNode(left >> level);
+    }
+    if (((right >> level) << level) != right) {
+      UpdateNode((right - 1) >> level);
+    }
+  }
+}
+
+// Answers the half-open leaf range [left, right) whose path has already been pushed; does not modify the tree.
+template<typename ValueMonoid, typename ActionMonoid, typename Enable>
+typename SegmentTree<ValueMonoid, ActionMonoid, Enable>::Value
+SegmentTree<ValueMonoid, ActionMonoid, Enable>::QueryPushed(size_t left, size_t right) const {
+  Value left_answer = ValueMonoid::Identity();
+  Value right_answer = ValueMonoid::Identity();
+  while (left < right) {
+    if (left & 1u) {
+      left_answer = ValueMonoid::Combine(left_answer, segment_tree_[left++]);
+    }
+    if (right & 1u) {
+      right_answer = ValueMonoid::Combine(segment_tree_[--right], right_answer);
+    }
+    left = Parent(left);
+    right = Parent(right);
+  }
+  return ValueMonoid::Combine(left_answer, right_answer);
+}
+
+template<typename ValueMonoid, typename ActionMonoid, typename Enable>
+typename SegmentTree<ValueMonoid, ActionMonoid, Enable>::Value
+SegmentTree<ValueMonoid, ActionMonoid, Enable>::Query(size_t left, size_t right) {
+  const size_t half_tree_size = FirstLeaf();
+  left += half_tree_size;
+  right += half_tree_size + 1;
+  PushPath(left, right);
+  return QueryPushed(left, right);
+}
+
+// Pushes the paths of all ranges first, so the answering phase only reads the tree.
+template<typename ValueMonoid, typename ActionMonoid, typename Enable>
+std::vector<typename SegmentTree<ValueMonoid, ActionMonoid, Enable>::Value>
+SegmentTree<ValueMonoid, ActionMonoid, Enable>::Query(const std::vector<std::pair<size_t, size_t>> &ranges) {
+  const size_t half_tree_size = FirstLeaf();
+  const auto sorted = SortQueries(ranges, size_, [](const std::pair<size_t, size_t> &range) {
+    return range.first;
+  });
+  for (const auto &range : sorted) {
+    PushPath(range.first.first + half_tree_size, range.first.second + half_tree_size + 1);
+  }
+  std::vector<Value> answers(ranges.size());
+  AnswerSortedQueries(sorted, answers,
+                      [this, half_tree_size](const std::pair<size_t, size_t> &range) {
+                        return QueryPushed(range.first + half_tree_size, range.second + half_tree_size + 1);
+                      },
+                      [this, half_tree_size](const std::pair<size_t, size_t> &range) {
+                        __builtin_prefetch(&segment_tree_[range.first + half_tree_size]);
+                        __builtin_prefetch(&segment_tree_[range.second + half_tree_size]);
+                      });
+  return answers;
+}
+
+////////////////////////////// class BlockSegmentTree (Declaration) //////////////////////////////
+
+/* Segment tree for commutative monoids over arithmetic types. Leaves are packed into cache line sized blocks,
+ blocks are reduced by a lane-parallel loop the compiler turns into SIMD code, and the tree is built over block
+ summaries only, so it is kBlockSize times smaller and a query touches two blocks plus O(log(n / kBlockSize)) nodes. */
+template<typename ValueMonoid>
+class BlockSegmentTree {
+ public:
+  typedef typename ValueMonoid::Type Value;
+
+ private:
+  static_assert(std::is_arithmetic<Value>::value, "BlockSegmentTree requires an arithmetic value type");
+
+  static constexpr size_t kCacheLineSize = 64;
+  static constexpr size_t kBlockSize = (sizeof(Value) < kCacheLineSize) ? kCacheLineSize / sizeof(Value) : 1;
+
+  struct alignas(kCacheLineSize) Block {
+    Value values_[kBlockSize];
   };
 
-  template<typename BinaryOperation>
-  T Query(size_t left, size_t right, const BinaryOperation &binary_operation, const T &pending_value) const;
+  size_t size_;
+  std::vector<Block> blocks_;
+  std::vector<Value> segment_tree_;
+
+  static size_t PowerOfTwo_Ceil(size_t value);
+
+  size_t Parent(size_t idx) const {
+    return idx / 2;
+  }
+
+  size_t LeftChild(size_t idx) const {
+    return idx * 2;
+  }
+
+  size_t RightChild(size_t idx) const {
+    return idx * 2 + 1;
+  }
+
+  static Value Reduce(const Value *begin, const Value *end);
+
+  Value Reduce(size_t left, size_t right) const;
+  Value QueryBlocks(size_t left, size_t right) const;
+  void UpdateBlock(size_t block_idx);
 
  public:
-  explicit SegmentTree(const std::vector<T> &values);
+  explicit BlockSegmentTree(const std::vector<Value> &values);
 
-  void Update(size_t idx, const T &value);
+  void Set(size_t idx, const Value &value);
 
-  T RSQ(size_t left, size_t right) const;
+  Value Get(size_t idx) const;
 
-  T RMQ(size_t left, size_t right) const;
+  Value Query(size_t left, size_t right) const;
+
+  std::vector<Value> Query(const std::vector<std::pair<size_t, size_t>> &ranges) const;
 };
 
-////////////////////////////// class SegmentTree (Implementation) //////////////////////////////
+////////////////////////////// class BlockSegmentTree (Implementation) //////////////////////////////
 
-template<typename T>
-SegmentTree<T>::Node::Node() {
-  min_ = min_pending_value_;
-  sum_ = sum_pending_value_;
+template<typename ValueMonoid>
+size_t BlockSegmentTree<ValueMonoid>::PowerOfTwo_Ceil(size_t value) {
+  size_t result = 1;
+  while (result < value) {
+    result *= 2;
+  }
+  return result;
 }
 
-template<typename T>
-SegmentTree<T>::Node::Node(const Node &first, const Node &second) {
-  sum_ = Summary_()(first, second);
-  min_ = Min_()(first, second);
+template<typename ValueMonoid>
+typename BlockSegmentTree<ValueMonoid>::Value BlockSegmentTree<ValueMonoid>::Reduce(const Value *begin,
+                                                                                    const Value *end) {
+  // Independent accumulators break the dependency chain and map onto vector lanes.
+  Value lanes[kBlockSize];
+  std::fill(lanes, lanes + kBlockSize, ValueMonoid::Identity());
+  for (; begin + kBlockSize <= end; begin += kBlockSize) {
+    for (size_t lane = 0; lane < kBlockSize; ++lane) {
+      lanes[lane] = ValueMonoid::Combine(lanes[lane], begin[lane]);
+    }
+  }
+  Value result = ValueMonoid::Identity();
+  for (; begin < end; ++begin) {
+    result = ValueMonoid::Combine(result, *begin);
+  }
+  for (size_t lane = 0; lane < kBlockSize; ++lane) {
+    result = ValueMonoid::Combine(result, lanes[lane]);
+  }
+  return result;
 }
 
-template<typename T>
-typename SegmentTree<T>::Node &SegmentTree<T>::Node::operator=(const T &value) {
-  min_ = value;
-  sum_ = value;
-  return *this;
+// Reduces the elements [left, right] lying in one block.
+template<typename ValueMonoid>
+typename BlockSegmentTree<ValueMonoid>::Value BlockSegmentTree<ValueMonoid>::Reduce(size_t left,
+                                                                                    size_t right) const {
+  const Value *values = blocks_[left / kBlockSize].values_;
+  return Reduce(values + left % kBlockSize, values + right % kBlockSize + 1);
 }
 
-template<typename T>
-template<typename BinaryOperation>
-T SegmentTree<T>::Query(size_t left, size_t right, const BinaryOperation &binary_operation,
-                        const T &pending_value) const {
-  T answer = pending_value;
-  const size_t tree_size = segment_tree_.size();
-  left += tree_size / 2;
-  right += tree_size / 2;
-  while (left <= right) {
-    if (left == RightChild(Parent(left))) {
-      answer = binary_operation(answer, segment_tree_[left]);
-    }
-    if (right == LeftChild(Parent(right))) {
-      answer = binary_operation(answer, segment_tree_[right]);
-    }
-    left = Parent(left + 1);
-    right = Parent(right - 1);
+template<typename ValueMonoid>
+typename BlockSegmentTree<ValueMonoid>::Value BlockSegmentTree<ValueMonoid>::QueryBlocks(size_t left,
+                                                                                         size_t right) const {
+  Value answer = ValueMonoid::Identity();
+  left += segment_tree_.size() / 2;
+  right += segment_tree_.size() / 2 + 1;
+  while (left < right) {
+    if (left & 1u) {
+      answer = ValueMonoid::Combine(answer, segment_tree_[left++]);
+    }
+    if (right & 1u) {
+      answer = ValueMonoid::Combine(answer, segment_tree_[--right]);
+    }
+    left = Parent(left);
+    right = Parent(right);
   }
   return answer;
 }
 
-template<typename T>
-size_t SegmentTree<T>::Log_2(size_t value) {
-  size_t result = 0;
-  while (value >>= 1u) {
-    ++result;
+template<typename ValueMonoid>
+void BlockSegmentTree<ValueMonoid>::UpdateBlock(size_t block_idx) {
+  const Value *values = blocks_[block_idx].values_;
+  size_t idx = block_idx + segment_tree_.size() / 2;
+  segment_tree_[idx] = Reduce(values, values + kBlockSize);
+  while ((idx = Parent(idx)) > 0) {
+    segment_tree_[idx] = ValueMonoid::Combine(segment_tree_[LeftChild(idx)], segment_tree_[RightChild(idx)]);
   }
-  return result;
 }
 
-template<typename T>
-size_t SegmentTree<T>::PowerOfTwo_Ceil(size_t value) {
-  return 1u << (Log_2(value - 1) + 1);
+template<typename ValueMonoid>
+BlockSegmentTree<ValueMonoid>::BlockSegmentTree(const std::vector<Value> &values)
+    : size_(values.size()),
+      blocks_((values.size() + kBlockSize - 1) / kBlockSize),
+      segment_tree_(2 * PowerOfTwo_Ceil(blocks_.size()), ValueMonoid::Identity()) {
+  const size_t half_tree_size = segment_tree_.size() / 2;
+  for (size_t block_idx = 0; block_idx < blocks_.size(); ++block_idx) {
+    Value *block = blocks_[block_idx].values_;
+    std::fill(block, block + kBlockSize, ValueMonoid::Identity());
+    for (size_t idx = block_idx * kBlockSize, end = std::min(size_, idx + kBlockSize); idx < end; ++idx) {
+      block[idx % kBlockSize] = values[idx];
+    }
+    segment_tree_[block_idx + half_tree_size] = Reduce(block, block + kBlockSize);
+  }
+  for (size_t idx = half_tree_size - 1; idx > 0; --idx) {
+    segment_tree_[idx] = ValueMonoid::Combine(segment_tree_[LeftChild(idx)], segment_tree_[RightChild(idx)]);
+  }
 }
 
-template<typename T>
-T SegmentTree<T>::Summary_::operator()(const Node &lhs, const Node &rhs) const {
-  return lhs.sum_ + rhs.sum_;
+template<typename ValueMonoid>
+void BlockSegmentTree<ValueMonoid>::Set(size_t idx, const Value &value) {
+  blocks_[idx / kBlockSize].values_[idx % kBlockSize] = value;
+  UpdateBlock(idx / kBlockSize);
 }
 
-template<typename T>
-T SegmentTree<T>::Summary_::operator()(const T &value, const Node &node) const {
-  return value + node.sum_;
+template<typename ValueMonoid>
+typename BlockSegmentTree<ValueMonoid>::Value BlockSegmentTree<ValueMonoid>::Get(size_t idx) const {
+  return blocks_[idx / kBlockSize].values_[idx % kBlockSize];
 }
 
-template<typename T>
-T SegmentTree<T>::Min_::operator()(const Node &lhs, const Node &rhs) const {
-  return std::min(lhs.min_, rhs.min_);
+template<typename ValueMonoid>
+typename BlockSegmentTree<ValueMonoid>::Value BlockSegmentTree<ValueMonoid>::Query(size_t left,
+                                                                                   size_t right) const {
+  const size_t left_block = left / kBlockSize;
+  const size_t right_block = right / kBlockSize;
+  if (left_block == right_block) {
+    return Reduce(left, right);
+  }
+  Value answer = ValueMonoid::Combine(Reduce(left, left_block * kBlockSize + kBlockSize - 1),
+                                      Reduce(right_block * kBlockSize, right));
+  if (left_block + 1 < right_block) {
+    answer = ValueMonoid::Combine(answer, QueryBlocks(left_block + 1, right_block - 1));
+  }
+  return answer;
 }
 
-template<typename T>
-T SegmentTree<T>::Min_::operator()(const T &value, const Node &node) const {
-  return std::min(value, node.min_);
+// The tree over block summaries is small enough to stay in cache, so ranges are answered in the given order.
+template<typename ValueMonoid>
+std::vector<typename BlockSegmentTree<ValueMonoid>::Value>
+BlockSegmentTree<ValueMonoid>::Query(const std::vector<std::pair<size_t, size_t>> &ranges) const {
+  std::vector<std::pair<std::pair<size_t, size_t>, size_t>> indexed;
+  indexed.reserve(ranges.size());
+  for (size_t idx = 0; idx < ranges.size(); ++idx) {
+    indexed.emplace_back(ranges[idx], idx);
+  }
+  std::vector<Value> answers(ranges.size());
+  AnswerSortedQueries(indexed, answers,
+                      [this](const std::pair<size_t, size_t> &range) {
+                        return Query(range.first, range.second);
+                      },
+                      [this](const std::pair<size_t, size_t> &range) {
+                        __builtin_prefetch(blocks_[range.first / kBlockSize].values_);
+                        __builtin_prefetch(blocks_[range.second / kBlockSize].values_);
+                      });
+  return answers;
 }
 
+////////////////////////////// SegmentTree specializations //////////////////////////////
+
+/* Sum, Min and Max without lazy actions are commutative, so they are served by BlockSegmentTree when the value type
+ allows it: Min and Max over any arithmetic type, Sum over integers only. Lane-wise reduction reorders additions,
+ so floating point sums stay on the generic tree and keep its summation order; other value types do as well. */
 template<typename T>
-SegmentTree<T>::SegmentTree(const std::vector<T> &values)
-    : segment_tree_(2 * PowerOfTwo_Ceil(values.size())) {
-  const size_t half_tree_size = segment_tree_.size() / 2;
-  const size_t values_size = values.size();
-  for (size_t idx = values_size; idx < PowerOfTwo_Ceil(values.size()); ++idx) {
-    segment_tree_[idx + half_tree_size] = Node();
+class SegmentTree<Sum<T>, NoAction, typename std::enable_if<std::is_integral<T>::value>::type>
+    : public BlockSegmentTree<Sum<T>> {
+ public:
+  using BlockSegmentTree<Sum<T>>::BlockSegmentTree;
+};
+
+template<typename T>
+class SegmentTree<Min<T>, NoAction, typename std::enable_if<std::is_arithmetic<T>::value>::type>
+    : public BlockSegmentTree<Min<T>> {
+ public:
+  using BlockSegmentTree<Min<T>>::BlockSegmentTree;
+};
+
+template<typename T>
+class SegmentTree<Max<T>, NoAction, typename std::enable_if<std::is_arithmetic<T>::value>::type>
+    : public BlockSegmentTree<Max<T>> {
+ public:
+  using BlockSegmentTree<Max<T>>::BlockSegmentTree;
+};
+
+////////////////////////////// class PersistentSegmentTree (Declaration) //////////////////////////////
+
+/* Segment tree keeping every version of the array. Set copies the root-to-leaf path only (ceil(log n) + 1 new nodes),
+ the rest is shared with the previous version; nodes live in one arena and refer to children by index. */
+template<typename ValueMonoid>
+class PersistentSegmentTree {
+ public:
+  typedef typename ValueMonoid::Type Value;
+  typedef size_t Version;
+
+ private:
+  struct Node {
+    Value value_;
+    size_t left_child_;
+    size_t right_child_;
+  };
+
+  size_t size_;
+  std::vector<Node> nodes_;
+  std::vector<size_t> roots_;
+
+  size_t AddNode(const Value &value, size_t left_child, size_t right_child);
+  size_t Build(const std::vector<Value> &values, size_t left, size_t right);
+  size_t Set(size_t node, size_t node_left, size_t node_right, size_t idx, const Value &value);
+  Value Query(size_t node, size_t node_left, size_t node_right, size_t left, size_t right) const;
+
+ public:
+  explicit PersistentSegmentTree(const std::vector<Value> &values);
+
+  // Returns the version equal to the given one except for the element idx.
+  Version Set(Version version, size_t idx, const Value &value);
+
+  Value Get(Version version, size_t idx) const;
+
+  Value Query(Version version, size_t left, size_t right) const;
+
+  Version GetLatestVersion() const;
+};
+
+////////////////////////////// class PersistentSegmentTree (Implementation) //////////////////////////////
+
+template<typename ValueMonoid>
+size_t PersistentSegmentTree<ValueMonoid>::AddNode(const Value &value, size_t left_child, size_t right_child) {
+  nodes_.push_back({value, left_child, right_child});
+  return nodes_.size() - 1;
+}
+
+// Builds the subtree of the half-open range [left, right).
+template<typename ValueMonoid>
+size_t PersistentSegmentTree<ValueMonoid>::Build(const std::vector<Value> &values, size_t left, size_t right) {
+  if (right - left == 1) {
+    return AddNode(values[left], 0, 0);
   }
-  for (size_t idx = 0; idx < values_size; ++idx) {
-    segment_tree_[idx + half_tree_size] = values[idx];
+  const size_t middle = (left + right) / 2;
+  const size_t left_child = Build(values, left, middle);
+  const size_t right_child = Build(values, middle, right);
+  return AddNode(ValueMonoid::Combine(nodes_[left_child].value_, nodes_[right_child].value_), left_child, right_child);
+}
+
+template<typename ValueMonoid>
+size_t PersistentSegmentTree<ValueMonoid>::Set(size_t node, size_t node_left, size_t node_right, size_t idx,
+                                               const Value &value) {
+  if (node_right - node_left == 1) {
+    return AddNode(value, 0, 0);
   }
-  for (size_t idx = half_tree_size - 1; idx > 0; --idx) {
-    segment_tree_[idx] = Node(segment_tree_[LeftChild(idx)], segment_tree_[RightChild(idx)]);
+  const size_t middle = (node_left + node_right) / 2;
+  size_t left_child = nodes_[node].left_child_;
+  size_t right_child = nodes_[node].right_child_;
+  if (idx < middle) {
+    left_child = Set(left_child, node_left, middle, idx, value);
+  } else {
+    right_child = Set(right_child, middle, node_right, idx, value);
   }
+  return AddNode(ValueMonoid::Combine(nodes_[left_child].value_, nodes_[right_child].value_), left_child, right_child);
 }
 
-template<typename T>
-void SegmentTree<T>::Update(size_t idx, const T &value) {
-  idx += segment_tree_.size() / 2;
-  segment_tree_[idx] = value;
-  while ((idx = Parent(idx)) > 0) {
-    segment_tree_[idx] = Node(segment_tree_[LeftChild(idx)], segment_tree_[RightChild(idx)]);
+// Answers [left, right) inside the node covering [node_left, node_right).
+template<typename ValueMonoid>
+typename PersistentSegmentTree<ValueMonoid>::Value
+PersistentSegmentTree<ValueMonoid>::Query(size_t node, size_t node_left, size_t node_right, size_t left,
+                                          size_t right) const {
+  if (left <= node_left && node_right <= right) {
+    return nodes_[node].value_;
   }
+  const size_t middle = (node_left + node_right) / 2;
+  Value answer = ValueMonoid::Identity();
+  if (left < middle) {
+    answer = ValueMonoid::Combine(answer, Query(nodes_[node].left_child_, node_left, middle, left, right));
+  }
+  if (middle < right) {
+    answer = ValueMonoid::Combine(answer, Query(nodes_[node].right_child_, middle, node_right, left, right));
+  }
+  return answer;
 }
 
-template<typename T>
-T SegmentTree<T>::RSQ(size_t left, size_t right) const {
-  return Query(left, right, Summary_(), Node::sum_pending_value_);
+template<typename ValueMonoid>
+PersistentSegmentTree<ValueMonoid>::PersistentSegmentTree(const std::vector<Value> &values)
+    : size_(values.size()) {
+  nodes_.reserve(2 * size_);
+  roots_.push_back(size_ > 0 ? Build(values, 0, size_) : AddNode(ValueMonoid::Identity(), 0, 0));
 }
 
-template<typename T>
-T SegmentTree<T>::RMQ(size_t left, size_t right) const {
-  return Query(left, right, Min_(), Node::min_pending_value_);
+template<typename ValueMonoid>
+typename PersistentSegmentTree<ValueMonoid>::Version
+PersistentSegmentTree<ValueMonoid>::Set(Version version, size_t idx, const Value &value) {
+  roots_.push_back(Set(roots_[version], 0, size_, idx, value));
+  return roots_.size() - 1;
+}
+
+template<typename ValueMonoid>
+typename PersistentSegmentTree<ValueMonoid>::Value
+PersistentSegmentTree<ValueMonoid>::Get(Version version, size_t idx) const {
+  size_t node = roots_[version];
+  size_t node_left = 0;
+  size_t node_right = size_;
+  while (node_right - node_left > 1) {
+    const size_t middle = (node_left + node_right) / 2;
+    if (idx < middle) {
+      node = nodes_[node].left_child_;
+      node_right = middle;
+    } else {
+      node = nodes_[node].right_child_;
+      node_left = middle;
+    }
+  }
+  return nodes_[node].value_;
+}
+
+template<typename ValueMonoid>
+typename PersistentSegmentTree<ValueMonoid>::Value
+PersistentSegmentTree<ValueMonoid>::Query(Version version, size_t left, size_t right) const {
+  return Query(roots_[version], 0, size_, left, right + 1);
+}
+
+template<typename ValueMonoid>
+typename PersistentSegmentTree<ValueMonoid>::Version PersistentSegmentTree<ValueMonoid>::GetLatestVersion() const {
+  return roots_.size() - 1;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -218,23 +802,33 @@ int main() {
     std::cin >> values[i];
   }
 
-  SegmentTree<int64_t> segment_tree(values);
+  SegmentTree<Sum<int64_t>> segment_tree(values);
   size_t quires_num;
   std::cin >> quires_num;
+  // Consecutive sum queries are answered in one batch before the next update.
+  std::vector<std::pair<size_t, size_t>> ranges;
+  auto answer_ranges = [&segment_tree, &ranges]() {
+    for (int64_t sum : segment_tree.Query(ranges)) {
+      std::cout << sum << ' ';
+    }
+    ranges.clear();
+  };
   for (size_t i = 0; i < quires_num; ++i) {
     char query;
     std::cin >> query;
     if (query == 's') {
       size_t left, right;
       std::cin >> left >> right;
-      std::cout << segment_tree.RSQ(left - 1, right - 1) << ' ';
+      ranges.emplace_back(left - 1, right - 1);
     } else if (query == 'u') {
       size_t idx;
       int64_t value;
       std::cin >> idx >> value;
-      segment_tree.Update(idx - 1, value);
+      answer_ranges();
+      segment_tree.Set(idx - 1, value);
     }
   }
+  answer_ranges();
 
   return 0;
 }
\ No newline at end of file
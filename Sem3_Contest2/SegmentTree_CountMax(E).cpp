@@ -28,143 +28,295 @@ Input	     Output
 #include <iostream>
 #include <vector>
 #include <algorithm>
-#include <memory>
 #include <limits>
+#include <utility>
 
-////////////////////////////// class SegmentTree (Declaration) //////////////////////////////
+////////////////////////////// Monoids //////////////////////////////
 
 template<typename T>
-class SegmentTree {
- private:
-  struct Node {
+struct MaxCount {
+  struct Type {
     T max_;
     size_t max_count_;
-    static constexpr T pending_value_ = T(0);
+  };
 
-    Node();
+  static Type Identity() {
+    return {std::numeric_limits<T>::lowest(), 0};
+  }
 
-    Node(const Node &first, const Node &second);
+  static Type Combine(const Type &lhs, const Type &rhs) {
+    if (lhs.max_ == rhs.max_) {
+      return {lhs.max_, lhs.max_count_ + rhs.max_count_};
+    }
+    return (lhs.max_ > rhs.max_) ? lhs : rhs;
+  }
+};
 
-    Node &operator=(const T &value);
-  };
+struct NoAction {
+  typedef bool Type;
+
+  static Type Identity() {
+    return false;
+  }
+
+  static Type Compose(const Type &, const Type &) {
+    return false;
+  }
+
+  template<typename Value>
+  static Value Apply(const Type &, const Value &value, size_t) {
+    return value;
+  }
+};
+
+////////////////////////////// Batch queries //////////////////////////////
+
+// Counting sort of the queries by key(query) < key_limit; each query keeps its original position.
+template<typename Query, typename Key>
+std::vector<std::pair<Query, size_t>> SortQueries(const std::vector<Query> &queries, size_t key_limit, const Key &key) {
+  const size_t buckets_count = queries.size() + 1;
+  std::vector<size_t> bucket(queries.size());
+  std::vector<size_t> bucket_begin(buckets_count + 1, 0);
+  for (size_t idx = 0; idx < queries.size(); ++idx) {
+    bucket[idx] = key(queries[idx]) * buckets_count / std::max<size_t>(1, key_limit);
+    ++bucket_begin[bucket[idx] + 1];
+  }
+  for (size_t idx = 0; idx < buckets_count; ++idx) {
+    bucket_begin[idx + 1] += bucket_begin[idx];
+  }
+  std::vector<size_t> order(queries.size());
+  for (size_t idx = 0; idx < queries.size(); ++idx) {
+    order[bucket_begin[bucket[idx]]++] = idx;
+  }
+  std::vector<std::pair<Query, size_t>> sorted;
+  sorted.reserve(queries.size());
+  for (size_t idx : order) {
+    sorted.emplace_back(queries[idx], idx);
+  }
+  return sorted;
+}
+
+// Answers the queries in sorted order, issuing prefetch(query) kPrefetchDistance queries in advance.
+template<typename Query, typename Answer, typename AnswerQuery, typename Prefetch>
+void AnswerSortedQueries(const std::vector<std::pair<Query, size_t>> &sorted, std::vector<Answer> &answers,
+                         const AnswerQuery &answer_query, const Prefetch &prefetch) {
+  static constexpr size_t kPrefetchDistance = 8;
+  for (size_t idx = 0; idx < sorted.size(); ++idx) {
+    if (idx + kPrefetchDistance < sorted.size()) {
+      prefetch(sorted[idx + kPrefetchDistance].first);
+    }
+    answers[sorted[idx].second] = answer_query(sorted[idx].first);
+  }
+}
 
-  std::vector<Node> segment_tree_;
+////////////////////////////// class SegmentTree (Declaration) //////////////////////////////
+
+/* Bottom-up segment tree with lazy propagation.
+ ValueMonoid:  Type, Identity(), Combine(lhs, rhs) - associative, not necessarily commutative.
+ ActionMonoid: Type, Identity(), Compose(outer, inner) - action "outer after inner",
+               Apply(action, value, length) - result of the action on a segment of length elements. */
+template<typename ValueMonoid, typename ActionMonoid = NoAction>
+class SegmentTree {
+ public:
+  typedef typename ValueMonoid::Type Value;
+  typedef typename ActionMonoid::Type Action;
+
+ private:
+  size_t size_;
+  size_t height_;
+  std::vector<Value> segment_tree_;
+  std::vector<Action> pending_;
 
   static size_t Log_2(size_t value);
   static size_t PowerOfTwo_Ceil(size_t value);
 
-  T Parent(size_t idx) const {
+  size_t Parent(size_t idx) const {
     return idx / 2;
   }
 
-  T LeftChild(size_t idx) const {
+  size_t LeftChild(size_t idx) const {
     return idx * 2;
   }
 
-  T RightChild(size_t idx) const {
+  size_t RightChild(size_t idx) const {
     return idx * 2 + 1;
   }
 
-  struct Max_ {
-    Node operator()(const Node &lhs, const Node &rhs) const;
-  };
-
-  template<typename BinaryOperation>
-  Node Query(size_t left, size_t right, const BinaryOperation &binary_operation) const;
+  void ApplyToNode(size_t idx, const Action &action, size_t length);
+  void PushToChildren(size_t idx, size_t length);
+  void PushPath(size_t left, size_t right);
+  void UpdateNode(size_t idx);
+  Value QueryPushed(size_t left, size_t right) const;
 
  public:
-  explicit SegmentTree(const std::vector<T> &values);
+  explicit SegmentTree(const std::vector<Value> &values);
+
+  void Set(size_t idx, const Value &value);
+
+  Value Get(size_t idx);
+
+  void Update(size_t left, size_t right, const Action &action);
 
-  Node RmaxQ(size_t left, size_t right) const;
+  Value Query(size_t left, size_t right);
+
+  std::vector<Value> Query(const std::vector<std::pair<size_t, size_t>> &ranges);
 };
 
 ////////////////////////////// class SegmentTree (Implementation) //////////////////////////////
 
-template<typename T>
-SegmentTree<T>::Node::Node() {
-  max_ = pending_value_;
-  max_count_ = pending_value_;
+template<typename ValueMonoid, typename ActionMonoid>
+size_t SegmentTree<ValueMonoid, ActionMonoid>::Log_2(size_t value) {
+  size_t result = 0;
+  while (value >>= 1u) {
+    ++result;
+  }
+  return result;
 }
 
-template<typename T>
-SegmentTree<T>::Node::Node(const Node &first, const Node &second) {
-  Node node = Max_()(first, second);
-  max_ = node.max_;
-  max_count_ = node.max_count_;
+template<typename ValueMonoid, typename ActionMonoid>
+size_t SegmentTree<ValueMonoid, ActionMonoid>::PowerOfTwo_Ceil(size_t value) {
+  return (value <= 1) ? 1 : size_t(1) << (Log_2(value - 1) + 1);
 }
 
-template<typename T>
-typename SegmentTree<T>::Node &SegmentTree<T>::Node::operator=(const T &value) {
-  max_ = value;
-  max_count_ = 1;
-  return *this;
+template<typename ValueMonoid, typename ActionMonoid>
+SegmentTree<ValueMonoid, ActionMonoid>::SegmentTree(const std::vector<Value> &values)
+    : size_(values.size()),
+      height_(Log_2(PowerOfTwo_Ceil(values.size()))),
+      segment_tree_(2 * PowerOfTwo_Ceil(values.size()), ValueMonoid::Identity()),
+      pending_(PowerOfTwo_Ceil(values.size()), ActionMonoid::Identity()) {
+  const size_t half_tree_size = segment_tree_.size() / 2;
+  for (size_t idx = 0; idx < size_; ++idx) {
+    segment_tree_[idx + half_tree_size] = values[idx];
+  }
+  for (size_t idx = half_tree_size - 1; idx > 0; --idx) {
+    UpdateNode(idx);
+  }
 }
 
-template<typename T>
-template<typename BinaryOperation>
-typename SegmentTree<T>::Node SegmentTree<T>::Query(size_t left, size_t right, const BinaryOperation &binary_operation) const {
-  Node answer = Node();
-  const size_t tree_size = segment_tree_.size();
-  left += tree_size / 2;
-  right += tree_size / 2;
-  while (left <= right) {
-    if (left == RightChild(Parent(left))) {
-      answer = binary_operation(answer, segment_tree_[left]);
+template<typename ValueMonoid, typename ActionMonoid>
+void SegmentTree<ValueMonoid, ActionMonoid>::ApplyToNode(size_t idx, const Action &action, size_t length) {
+  segment_tree_[idx] = ActionMonoid::Apply(action, segment_tree_[idx], length);
+  if (idx < pending_.size()) {
+    pending_[idx] = ActionMonoid::Compose(action, pending_[idx]);
+  }
+}
+
+template<typename ValueMonoid, typename ActionMonoid>
+void SegmentTree<ValueMonoid, ActionMonoid>::PushToChildren(size_t idx, size_t length) {
+  ApplyToNode(LeftChild(idx), pending_[idx], length / 2);
+  ApplyToNode(RightChild(idx), pending_[idx], length / 2);
+  pending_[idx] = ActionMonoid::Identity();
+}
+
+// Pushes pending actions down to the borders of the half-open leaf range [left, right).
+template<typename ValueMonoid, typename ActionMonoid>
+void SegmentTree<ValueMonoid, ActionMonoid>::PushPath(size_t left, size_t right) {
+  for (size_t level = height_; level > 0; --level) {
+    if (((left >> level) << level) != left) {
+      PushToChildren(left >> level, size_t(1) << level);
     }
-    if (right == LeftChild(Parent(right))) {
-      answer = binary_operation(answer, segment_tree_[right]);
+    if (((right >> level) << level) != right) {
+      PushToChildren((right - 1) >> level, size_t(1) << level);
     }
-    left = Parent(left + 1);
-    right = Parent(right - 1);
   }
-  return answer;
 }
 
-template<typename T>
-size_t SegmentTree<T>::Log_2(size_t value) {
-  size_t result = 0;
-  while (value >>= 1u) {
-    ++result;
-  }
-  return result;
+template<typename ValueMonoid, typename ActionMonoid>
+void SegmentTree<ValueMonoid, ActionMonoid>::UpdateNode(size_t idx) {
+  segment_tree_[idx] = ValueMonoid::Combine(segment_tree_[LeftChild(idx)], segment_tree_[RightChild(idx)]);
 }
 
-template<typename T>
-size_t SegmentTree<T>::PowerOfTwo_Ceil(size_t value) {
-  return 1u << (Log_2(value - 1) + 1);
+template<typename ValueMonoid, typename ActionMonoid>
+void SegmentTree<ValueMonoid, ActionMonoid>::Set(size_t idx, const Value &value) {
+  idx += segment_tree_.size() / 2;
+  PushPath(idx, idx + 1);
+  segment_tree_[idx] = value;
+  while ((idx = Parent(idx)) > 0) {
+    UpdateNode(idx);
+  }
 }
 
-template<typename T>
-typename SegmentTree<T>::Node SegmentTree<T>::Max_::operator()(const Node &lhs, const Node &rhs) const {
-  Node node;
-  node.max_ = std::max(lhs.max_, rhs.max_);
-  if (lhs.max_ == rhs.max_) {
-    node.max_count_ = lhs.max_count_ + rhs.max_count_;
-  } else {
-    node.max_count_ = (lhs.max_ > rhs.max_) ? lhs.max_count_ : rhs.max_count_;
-  }
-  return node;
+template<typename ValueMonoid, typename ActionMonoid>
+typename SegmentTree<ValueMonoid, ActionMonoid>::Value SegmentTree<ValueMonoid, ActionMonoid>::Get(size_t idx) {
+  idx += segment_tree_.size() / 2;
+  PushPath(idx, idx + 1);
+  return segment_tree_[idx];
 }
 
-template<typename T>
-SegmentTree<T>::SegmentTree(const std::vector<T> &values)
-    : segment_tree_(2 * PowerOfTwo_Ceil(values.size())) {
+template<typename ValueMonoid, typename ActionMonoid>
+void SegmentTree<ValueMonoid, ActionMonoid>::Update(size_t left, size_t right, const Action &action) {
   const size_t half_tree_size = segment_tree_.size() / 2;
-  const size_t values_size = values.size();
-  for (size_t idx = values_size; idx < PowerOfTwo_Ceil(values.size()); ++idx) {
-    segment_tree_[idx + half_tree_size] = Node();
+  left += half_tree_size;
+  right += half_tree_size + 1;
+  PushPath(left, right);
+  for (size_t lhs = left, rhs = right, length = 1; lhs < rhs; lhs = Parent(lhs), rhs = Parent(rhs), length *= 2) {
+    if (lhs & 1u) {
+      ApplyToNode(lhs++, action, length);
+    }
+    if (rhs & 1u) {
+      ApplyToNode(--rhs, action, length);
+    }
   }
-  for (size_t idx = 0; idx < values_size; ++idx) {
-    segment_tree_[idx + half_tree_size] = values[idx];
+  for (size_t level = 1; level <= height_; ++level) {
+    if (((left >> level) << level) != left) {
+      UpdateNode(left >> level);
+    }
+    if (((right >> level) << level) != right) {
+      UpdateNode((right - 1) >> level);
+    }
   }
-  for (size_t idx = half_tree_size - 1; idx > 0; --idx) {
-    segment_tree_[idx] = Node(segment_tree_[LeftChild(idx)], segment_tree_[RightChild(idx)]);
+}
+
+// Answers the half-open leaf range [left, right) whose path has already been pushed; does not modify the tree.
+template<typename ValueMonoid, typename ActionMonoid>
+typename SegmentTree<ValueMonoid, ActionMonoid>::Value
+SegmentTree<ValueMonoid, ActionMonoid>::QueryPushed(size_t left, size_t right) const {
+  Value left_answer = ValueMonoid::Identity();
+  Value right_answer = ValueMonoid::Identity();
+  while (left < right) {
+    if (left & 1u) {
+      left_answer = ValueMonoid::Combine(left_answer, segment_tree_[left++]);
+    }
+    if (right & 1u) {
+      right_answer = ValueMonoid::Combine(segment_tree_[--right], right_answer);
+    }
+    left = Parent(left);
+    right = Parent(right);
   }
+  return ValueMonoid::Combine(left_answer, right_answer);
 }
 
-template<typename T>
-typename SegmentTree<T>::Node SegmentTree<T>::RmaxQ(size_t left, size_t right) const {
-  return Query(left, right, Max_());
+template<typename ValueMonoid, typename ActionMonoid>
+typename SegmentTree<ValueMonoid, ActionMonoid>::Value
+SegmentTree<ValueMonoid, ActionMonoid>::Query(size_t left, size_t right) {
+  const size_t half_tree_size = segment_tree_.size() / 2;
+  left += half_tree_size;
+  right += half_tree_size + 1;
+  PushPath(left, right);
+  return QueryPushed(left, right);
+}
+
+// Every path is pushed before answering, after that the ranges are answered without touching pending_.
+template<typename ValueMonoid, typename ActionMonoid>
+std::vector<typename SegmentTree<ValueMonoid, ActionMonoid>::Value>
+SegmentTree<ValueMonoid, ActionMonoid>::Query(const std::vector<std::pair<size_t, size_t>> &ranges) {
+  const size_t half_tree_size = segment_tree_.size() / 2;
+  const auto sorted = SortQueries(ranges, size_, [](const std::pair<size_t, size_t> &range) {
+    return range.first;
+  });
+  for (const auto &range : sorted) {
+    PushPath(range.first.first + half_tree_size, range.first.second + half_tree_size + 1);
+  }
+  std::vector<Value> answers(ranges.size());
+  AnswerSortedQueries(sorted, answers,
+                      [this, half_tree_size](const std::pair<size_t, size_t> &range) {
+                        return QueryPushed(range.first + half_tree_size, range.second + half_tree_size + 1);
+                      },
+                      [this, half_tree_size](const std::pair<size_t, size_t> &range) {
+                        __builtin_prefetch(&segment_tree_[range.first + half_tree_size]);
+                        __builtin_prefetch(&segment_tree_[range.second + half_tree_size]);
+                      });
+  return answers;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -172,18 +324,22 @@ typename SegmentTree<T>::Node SegmentTree<T>::RmaxQ(size_t left, size_t right) c
 int main() {
   size_t values_num;
   std::cin >> values_num;
-  std::vector<int64_t> values(values_num);
+  std::vector<MaxCount<int64_t>::Type> values(values_num);
   for (size_t i = 0; i < values_num; ++i) {
-    std::cin >> values[i];
+    std::cin >> values[i].max_;
+    values[i].max_count_ = 1;
   }
 
-  SegmentTree<int64_t> segment_tree(values);
+  SegmentTree<MaxCount<int64_t>> segment_tree(values);
   size_t quires_num;
   std::cin >> quires_num;
+  std::vector<std::pair<size_t, size_t>> ranges(quires_num);
   for (size_t i = 0; i < quires_num; ++i) {
     size_t left, right;
     std::cin >> left >> right;
-    auto node = segment_tree.RmaxQ(left - 1, right - 1);
+    ranges[i] = {left - 1, right - 1};
+  }
+  for (const auto &node : segment_tree.Query(ranges)) {
     std::cout << node.max_ << ' ' << node.max_count_ << std::endl;
   }
 
@@ -33,43 +33,115 @@ g 4
 #include <iostream>
 #include <vector>
 #include <algorithm>
-#include <memory>
 #include <limits>
 
-////////////////////////////// class SegmentTree (Declaration) //////////////////////////////
+////////////////////////////// Monoids //////////////////////////////
 
 template<typename T>
+struct Sum {
+  typedef T Type;
+
+  static Type Identity() {
+    return T(0);
+  }
+
+  static Type Combine(const Type &lhs, const Type &rhs) {
+    return lhs + rhs;
+  }
+};
+
+struct NoAction {
+  typedef bool Type;
+
+  static Type Identity() {
+    return false;
+  }
+
+  static Type Compose(const Type &, const Type &) {
+    return false;
+  }
+
+  template<typename Value>
+  static Value Apply(const Type &, const Value &value, size_t) {
+    return value;
+  }
+};
+
+// Adds a constant to every element of the segment.
+template<typename ValueMonoid>
+struct RangeAdd;
+
+template<typename T>
+struct RangeAdd<Sum<T>> {
+  typedef T Type;
+
+  static Type Identity() {
+    return T(0);
+  }
+
+  static Type Compose(const Type &outer, const Type &inner) {
+    return outer + inner;
+  }
+
+  static T Apply(const Type &action, const T &value, size_t length) {
+    return value + action * static_cast<T>(length);
+  }
+};
+
+////////////////////////////// class SegmentTree (Declaration) //////////////////////////////
+
+/* Bottom-up segment tree with lazy propagation.
+ ValueMonoid:  Type, Identity(), Combine(lhs, rhs) - associative, not necessarily commutative.
+ ActionMonoid: Type, Identity(), Compose(outer, inner) - action "outer after inner",
+               Apply(action, value, length) - result of the action on a segment of length elements. */
+template<typename ValueMonoid, typename ActionMonoid = NoAction>
 class SegmentTree {
+ public:
+  typedef typename ValueMonoid::Type Value;
+  typedef typename ActionMonoid::Type Action;
+
  private:
-  std::vector<T> segment_tree_;
+  size_t size_;
+  size_t height_;
+  std::vector<Value> segment_tree_;
+  std::vector<Action> pending_;
 
   static size_t Log_2(size_t value);
   static size_t PowerOfTwo_Ceil(size_t value);
 
-  T Parent(int64_t idx) const {
+  size_t Parent(size_t idx) const {
     return idx / 2;
   }
 
-  T LeftChild(int64_t idx) const {
+  size_t LeftChild(size_t idx) const {
     return idx * 2;
   }
 
-  T RightChild(int64_t idx) const {
+  size_t RightChild(size_t idx) const {
     return idx * 2 + 1;
   }
 
+  void ApplyToNode(size_t idx, const Action &action, size_t length);
+  void PushToChildren(size_t idx, size_t length);
+  void PushPath(size_t left, size_t right);
+  void UpdateNode(size_t idx);
+
  public:
-  explicit SegmentTree(const std::vector<T> &values);
+  explicit SegmentTree(const std::vector<Value> &values);
+
+  void Set(size_t idx, const Value &value);
 
-  void Update(size_t left, size_t right, const T &value);
+  Value Get(size_t idx);
 
-  T GetValue(size_t idx) const;
+  void Update(size_t left, size_t right, const Action &action);
+
+  Value Query(size_t left, size_t right);
 };
 
 ////////////////////////////// class SegmentTree (Implementation) //////////////////////////////
 
-template<typename T>
-size_t SegmentTree<T>::Log_2(size_t value) {
+template<typename ValueMonoid, typename ActionMonoid>
+size_t SegmentTree<ValueMonoid, ActionMonoid>::Log_2(size_t value) {
   size_t result = 0;
   while (value >>= 1u) {
     ++result;
@@ -77,46 +149,120 @@ size_t SegmentTree<T>::Log_2(size_t value) {
   return result;
 }
 
-template<typename T>
-size_t SegmentTree<T>::PowerOfTwo_Ceil(size_t value) {
-  return 1u << (Log_2(value - 1) + 1);
+template<typename ValueMonoid, typename ActionMonoid>
+size_t SegmentTree<ValueMonoid, ActionMonoid>::PowerOfTwo_Ceil(size_t value) {
+  return (value <= 1) ? 1 : size_t(1) << (Log_2(value - 1) + 1);
 }
 
-template<typename T>
-SegmentTree<T>::SegmentTree(const std::vector<T> &values)
-    : segment_tree_(2 * PowerOfTwo_Ceil(values.size()), T(0)) {
-  const int64_t half_tree_size = segment_tree_.size() / 2;
-  const int64_t values_size = values.size();
-  for (int64_t idx = 0; idx < values_size; ++idx) {
+template<typename ValueMonoid, typename ActionMonoid>
+SegmentTree<ValueMonoid, ActionMonoid>::SegmentTree(const std::vector<Value> &values)
+    : size_(values.size()),
+      height_(Log_2(PowerOfTwo_Ceil(values.size()))),
+      segment_tree_(2 * PowerOfTwo_Ceil(values.size()), ValueMonoid::Identity()),
+      pending_(PowerOfTwo_Ceil(values.size()), ActionMonoid::Identity()) {
+  const size_t half_tree_size = segment_tree_.size() / 2;
+  for (size_t idx = 0; idx < size_; ++idx) {
     segment_tree_[idx + half_tree_size] = values[idx];
   }
+  for (size_t idx = half_tree_size - 1; idx > 0; --idx) {
+    UpdateNode(idx);
+  }
 }
 
-template<typename T>
-void SegmentTree<T>::Update(size_t left, size_t right, const T &value) {
-  const int64_t tree_size = segment_tree_.size();
-  left += tree_size / 2;
-  right += tree_size / 2;
-  while (left <= right) {
-    if (left == RightChild(Parent(left))) {
-      segment_tree_[left] += value;
+template<typename ValueMonoid, typename ActionMonoid>
+void SegmentTree<ValueMonoid, ActionMonoid>::ApplyToNode(size_t idx, const Action &action, size_t length) {
+  segment_tree_[idx] = ActionMonoid::Apply(action, segment_tree_[idx], length);
+  if (idx < pending_.size()) {
+    pending_[idx] = ActionMonoid::Compose(action, pending_[idx]);
+  }
+}
+
+template<typename ValueMonoid, typename ActionMonoid>
+void SegmentTree<ValueMonoid, ActionMonoid>::PushToChildren(size_t idx, size_t length) {
+  ApplyToNode(LeftChild(idx), pending_[idx], length / 2);
+  ApplyToNode(RightChild(idx), pending_[idx], length / 2);
+  pending_[idx] = ActionMonoid::Identity();
+}
+
+// Pushes pending actions down to the borders of the half-open leaf range [left, right).
+template<typename ValueMonoid, typename ActionMonoid>
+void SegmentTree<ValueMonoid, ActionMonoid>::PushPath(size_t left, size_t right) {
+  for (size_t level = height_; level > 0; --level) {
+    if (((left >> level) << level) != left) {
+      PushToChildren(left >> level, size_t(1) << level);
     }
-    if (right == LeftChild(Parent(right))) {
-      segment_tree_[right] += value;
+    if (((right >> level) << level) != right) {
+      PushToChildren((right - 1) >> level, size_t(1) << level);
     }
-    left = Parent(left + 1);
-    right = Parent(right - 1);
   }
 }
 
-template<typename T>
-T SegmentTree<T>::GetValue(size_t idx) const {
+template<typename ValueMonoid, typename ActionMonoid>
+void SegmentTree<ValueMonoid, ActionMonoid>::UpdateNode(size_t idx) {
+  segment_tree_[idx] = ValueMonoid::Combine(segment_tree_[LeftChild(idx)], segment_tree_[RightChild(idx)]);
+}
+
+template<typename ValueMonoid, typename ActionMonoid>
+void SegmentTree<ValueMonoid, ActionMonoid>::Set(size_t idx, const Value &value) {
   idx += segment_tree_.size() / 2;
-  T value = segment_tree_[idx];
+  PushPath(idx, idx + 1);
+  segment_tree_[idx] = value;
   while ((idx = Parent(idx)) > 0) {
-    value += segment_tree_[idx];
+    UpdateNode(idx);
+  }
+}
+
+template<typename ValueMonoid, typename ActionMonoid>
+typename SegmentTree<ValueMonoid, ActionMonoid>::Value SegmentTree<ValueMonoid, ActionMonoid>::Get(size_t idx) {
+  idx += segment_tree_.size() / 2;
+  PushPath(idx, idx + 1);
+  return segment_tree_[idx];
+}
+
+template<typename ValueMonoid, typename ActionMonoid>
+void SegmentTree<ValueMonoid, ActionMonoid>::Update(size_t left, size_t right, const Action &action) {
+  const size_t half_tree_size = segment_tree_.size() / 2;
+  left += half_tree_size;
+  right += half_tree_size + 1;
+  PushPath(left, right);
+  for (size_t lhs = left, rhs = right, length = 1; lhs < rhs; lhs = Parent(lhs), rhs = Parent(rhs), length *= 2) {
+    if (lhs & 1u) {
+      ApplyToNode(lhs++, action, length);
+    }
+    if (rhs & 1u) {
+      ApplyToNode(--rhs, action, length);
+    }
+  }
+  for (size_t level = 1; level <= height_; ++level) {
+    if (((left >> level) << level) != left) {
+      UpdateNode(left >> level);
+    }
+    if (((right >> level) << level) != right) {
+      UpdateNode((right - 1) >> level);
+    }
+  }
+}
+
+template<typename ValueMonoid, typename ActionMonoid>
+typename SegmentTree<ValueMonoid, ActionMonoid>::Value SegmentTree<ValueMonoid, ActionMonoid>::Query(size_t left,
+                                                                                                     size_t right) {
+  const size_t half_tree_size = segment_tree_.size() / 2;
+  left += half_tree_size;
+  right += half_tree_size + 1;
+  PushPath(left, right);
+  Value left_answer = ValueMonoid::Identity();
+  Value right_answer = ValueMonoid::Identity();
+  while (left < right) {
+    if (left & 1u) {
+      left_answer = ValueMonoid::Combine(left_answer, segment_tree_[left++]);
+    }
+    if (right & 1u) {
+      right_answer = ValueMonoid::Combine(segment_tree_[--right], right_answer);
+    }
+    left = Parent(left);
+    right = Parent(right);
   }
-  return value;
+  return ValueMonoid::Combine(left_answer, right_answer);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -132,7 +278,7 @@ int main() {
     std::cin >> values[i];
   }
 
-  SegmentTree<int64_t> segment_tree(values);
+  SegmentTree<Sum<int64_t>, RangeAdd<Sum<int64_t>>> segment_tree(values);
   size_t quires_num;
   std::cin >> quires_num;
   for (size_t i = 0; i < quires_num; ++i) {
@@ -146,7 +292,7 @@ int main() {
     } else if (query == 'g') {
       size_t idx;
       std::cin >> idx;
-      std::cout << segment_tree.GetValue(idx - 1) << std::endl;
+      std::cout << segment_tree.Get(idx - 1) << std::endl;
     }
   }
 
@@ -31,6 +31,10 @@ Input	          Output
 #include <vector>
 #include <algorithm>
 #include <memory>
+#include <utility>
+#include <cstring>
+#include <type_traits>
+#include <cstdint>
 
 template<typename T>
 struct Min {
@@ -39,32 +43,344 @@ struct Min {
   }
 };
 
+// current_level[i] = function(previous_level[i], previous_level[i + half]) for i < count.
+template<typename T, typename Function>
+void BuildSparseTableLevel(const T *previous_level, T *current_level, size_t count, size_t half,
+                           const Function &function) {
+  for (size_t i = 0; i < count; ++i) {
+    current_level[i] = function(previous_level[i], previous_level[i + half]);
+  }
+}
+
+/* Min over arithmetic types of up to 4 bytes is built 16 bytes at a time with GCC vector extensions, whatever the
+ target flags are. Wider integers are left scalar: without SSE4.2 their lane-wise comparison is emulated and slower.
+ bool is left scalar too, vector_size does not accept it. */
+template<typename T, typename std::enable_if<std::is_arithmetic<T>::value && !std::is_same<T, bool>::value &&
+                                             sizeof(T) <= 4>::type * = nullptr>
+void BuildSparseTableLevel(const T *previous_level, T *current_level, size_t count, size_t half, const Min<T> &) {
+  typedef T Vector __attribute__((vector_size(16)));
+  static constexpr size_t kLanes = sizeof(Vector) / sizeof(T);
+  size_t i = 0;
+  for (; i + kLanes <= count; i += kLanes) {
+    Vector lhs, rhs;
+    std::memcpy(&lhs, previous_level + i, sizeof(Vector));
+    std::memcpy(&rhs, previous_level + i + half, sizeof(Vector));
+    const Vector result = (rhs < lhs) ? rhs : lhs;
+    std::memcpy(current_level + i, &result, sizeof(Vector));
+  }
+  for (; i < count; ++i) {
+    current_level[i] = std::min(previous_level[i], previous_level[i + half]);
+  }
+}
+
 template<typename T, typename Function>
 class SparseTable {
  private:
-  std::vector<std::vector<T>> sparse_table_;
+  // bool values are stored as char: std::vector<bool> is packed and has no data().
+  typedef typename std::conditional<std::is_same<T, bool>::value, char, T>::type Cell;
+
+  size_t size_;
+  // Level k (ranges of length 2^k) occupies [k * size_, k * size_ + size_ - 2^k + 1) of one allocation.
+  std::vector<Cell> sparse_table_;
   Function function_;
-  std::vector<size_t> log_2_;
+
+  static size_t Log_2(size_t value) {
+    return 63 - __builtin_clzll(value);
+  }
+
+ public:
+  explicit SparseTable(const std::vector<T> &values)
+      : size_(values.size()), sparse_table_(values.empty() ? 0 : (Log_2(values.size()) + 1) * values.size()) {
+    std::copy(values.begin(), values.end(), sparse_table_.begin());
+    for (size_t level = 1; (size_t(1) << level) <= size_; ++level) {
+      const size_t half = size_t(1) << (level - 1);
+      BuildSparseTableLevel(sparse_table_.data() + (level - 1) * size_, sparse_table_.data() + level * size_,
+                            size_ - 2 * half + 1, half, function_);
+    }
+  }
+
+  T Query(size_t left, size_t right) const {
+    const size_t level = Log_2(right - left + 1);
+    const Cell *values = sparse_table_.data() + level * size_;
+    return function_(values[left], values[right - (size_t(1) << level) + 1]);
+  }
+
+  // Answers ranges in the given order, prefetching the two cells of the range kPrefetchDistance steps ahead.
+  std::vector<T> Query(const std::vector<std::pair<size_t, size_t>> &ranges) const {
+    static constexpr size_t kPrefetchDistance = 16;
+    std::vector<T> answers(ranges.size());
+    for (size_t i = 0; i < ranges.size(); ++i) {
+      if (i + kPrefetchDistance < ranges.size()) {
+        const auto &range = ranges[i + kPrefetchDistance];
+        const size_t level = Log_2(range.second - range.first + 1);
+        const Cell *values = sparse_table_.data() + level * size_;
+        __builtin_prefetch(values + range.first);
+        __builtin_prefetch(values + range.second - (size_t(1) << level) + 1);
+      }
+      answers[i] = Query(ranges[i].first, ranges[i].second);
+    }
+    return answers;
+  }
+};
+
+/* Sparse table in O(n) memory for functions returning one of their arguments (Min, Max). Values are split into blocks
+ of kBlockSize; whole blocks are answered by a SparseTable over block results, a part of one block by the monotonic
+ stack mask: bit j of in_block_masks_[i] is set if the j-th value of the block wins against every value after it
+ up to i, so the answer on [left, right] is the lowest such bit of in_block_masks_[right] not below left. */
+template<typename T, typename Function>
+class BlockSparseTable {
+ private:
+  static constexpr size_t kBlockSize = 64;
+
+  std::vector<T> values_;
+  std::vector<uint64_t> in_block_masks_;
+  SparseTable<T, Function> blocks_table_;
+  Function function_;
+
+  static std::vector<T> GetBlocksResults(const std::vector<T> &values) {
+    Function function;
+    std::vector<T> blocks_results;
+    for (size_t block_begin = 0; block_begin < values.size(); block_begin += kBlockSize) {
+      T result = values[block_begin];
+      for (size_t i = block_begin + 1; i < std::min(values.size(), block_begin + kBlockSize); ++i) {
+        result = function(result, values[i]);
+      }
+      blocks_results.push_back(result);
+    }
+    return blocks_results;
+  }
+
+  T QueryInBlock(size_t left, size_t right) const {
+    const uint64_t mask = in_block_masks_[right] & (~uint64_t(0) << (left % kBlockSize));
+    return values_[right - right % kBlockSize + __builtin_ctzll(mask)];
+  }
+
+ public:
+  explicit BlockSparseTable(const std::vector<T> &values)
+      : values_(values), in_block_masks_(values.size()), blocks_table_(GetBlocksResults(values)) {
+    uint64_t stack = 0;
+    for (size_t i = 0; i < values_.size(); ++i) {
+      if (i % kBlockSize == 0) {
+        stack = 0;
+      }
+      const size_t block_begin = i - i % kBlockSize;
+      while (stack != 0) {
+        const size_t top = 63 - __builtin_clzll(stack);
+        if (!(function_(values_[i], values_[block_begin + top]) == values_[i])) {
+          break;
+        }
+        stack ^= uint64_t(1) << top;
+      }
+      stack |= uint64_t(1) << (i % kBlockSize);
+      in_block_masks_[i] = stack;
+    }
+  }
+
+  T Query(size_t left, size_t right) const {
+    const size_t left_block = left / kBlockSize;
+    const size_t right_block = right / kBlockSize;
+    if (left_block == right_block) {
+      return QueryInBlock(left, right);
+    }
+    T answer = function_(QueryInBlock(left, left_block * kBlockSize + kBlockSize - 1),
+                         QueryInBlock(right_block * kBlockSize, right));
+    if (left_block + 1 < right_block) {
+      answer = function_(answer, blocks_table_.Query(left_block + 1, right_block - 1));
+    }
+    return answer;
+  }
+};
+
+/* Sparse table for any associative function (sums, products modulo p, matrix products): the ranges it combines do
+ not overlap. On level k the array is cut into blocks of 2^k; a value left of the middle of its block stores the result
+ from it up to the middle, a value right of the middle - from the middle up to it. Query uses the level where left and
+ right first fall into the same block on different sides of the middle, so it applies function once. */
+template<typename T, typename Function>
+class DisjointSparseTable {
+ private:
+  size_t size_;
+  // Level k occupies [k * size_, (k + 1) * size_) of one allocation; level 0 holds the values.
+  std::vector<T> sparse_table_;
+  Function function_;
+
+  static size_t Log_2(size_t value) {
+    return 63 - __builtin_clzll(value);
+  }
+
+  static size_t GetLevelsCount(size_t size) {
+    return (size < 2) ? 1 : Log_2(size - 1) + 2;
+  }
 
  public:
-  explicit SparseTable(const std::vector<T> &values) : log_2_(values.size(), 0) {
-    const size_t table_size = values.size();
-    for (size_t i = 2; i < table_size; ++i) {
-      log_2_[i] = log_2_[i / 2] + 1;
-    }
-    sparse_table_.push_back(values);
-    for (size_t delta = 2; delta <= table_size; delta *= 2) {
-      std::vector<T> next_level_values(table_size - delta + 1);
-      for (size_t i = 0; i < next_level_values.size(); ++i) {
-        next_level_values[i] = function_(sparse_table_.back()[i], sparse_table_.back()[i + delta / 2]);
+  explicit DisjointSparseTable(const std::vector<T> &values)
+      : size_(values.size()), sparse_table_(GetLevelsCount(values.size()) * values.size()) {
+    std::copy(values.begin(), values.end(), sparse_table_.begin());
+    for (size_t level = 1; level < GetLevelsCount(size_); ++level) {
+      T *current_level = sparse_table_.data() + level * size_;
+      const size_t half = size_t(1) << (level - 1);
+      for (size_t middle = half; middle < size_; middle += 2 * half) {
+        current_level[middle - 1] = values[middle - 1];
+        for (size_t i = middle - 1; i > middle - half; --i) {
+          current_level[i - 1] = function_(values[i - 1], current_level[i]);
+        }
+        current_level[middle] = values[middle];
+        for (size_t i = middle + 1; i < std::min(size_, middle + half); ++i) {
+          current_level[i] = function_(current_level[i - 1], values[i]);
+        }
       }
-      sparse_table_.push_back(next_level_values);
     }
   }
 
   T Query(size_t left, size_t right) const {
-    size_t log_2 = log_2_[right - left];
-    return function_(sparse_table_[log_2][left], sparse_table_[log_2][right - (1u << log_2) + 1]);
+    if (left == right) {
+      return sparse_table_[left];
+    }
+    const T *values = sparse_table_.data() + (Log_2(left ^ right) + 1) * size_;
+    return function_(values[left], values[right]);
+  }
+};
+
+// Bit vector answering rank queries in O(1): ones are counted per 64-bit word in advance, the rest by popcount.
+class BitVector {
+ private:
+  static constexpr size_t kWordSize = 64;
+
+  std::vector<uint64_t> words_;
+  std::vector<size_t> ones_before_word_;
+
+ public:
+  explicit BitVector(size_t size = 0) : words_(size / kWordSize + 1, 0), ones_before_word_(size / kWordSize + 2, 0) {}
+
+  void SetBit(size_t idx) {
+    words_[idx / kWordSize] |= uint64_t(1) << (idx % kWordSize);
+  }
+
+  // Must be called after the last SetBit.
+  void BuildRank() {
+    for (size_t word = 0; word < words_.size(); ++word) {
+      ones_before_word_[word + 1] = ones_before_word_[word] + __builtin_popcountll(words_[word]);
+    }
+  }
+
+  // Number of ones among the first idx bits.
+  size_t RankOne(size_t idx) const {
+    const uint64_t lower_bits = (uint64_t(1) << (idx % kWordSize)) - 1;
+    return ones_before_word_[idx / kWordSize] + __builtin_popcountll(words_[idx / kWordSize] & lower_bits);
+  }
+
+  size_t RankZero(size_t idx) const {
+    return idx - RankOne(idx);
+  }
+};
+
+/* Wavelet matrix over the ranks of the values among the distinct ones (sigma of them). Level i holds the i-th bit
+ (from the top) of every rank, with the sequence stably sorted by the higher bits: zeros first, then ones.
+ Every query walks the levels once, so it takes O(log sigma). Ranges are inclusive, as in SparseTable::Query. */
+template<typename T>
+class WaveletMatrix {
+ private:
+  std::vector<T> distinct_values_;
+  size_t levels_;
+  std::vector<BitVector> levels_bits_;
+  std::vector<size_t> levels_zeros_;
+
+  // Number of elements in [left, right) with rank less than code.
+  size_t CountLessCode(size_t left, size_t right, size_t code) const {
+    if (code >> levels_) {
+      return right - left;
+    }
+    size_t count = 0;
+    for (size_t level = 0; level < levels_; ++level) {
+      const BitVector &bits = levels_bits_[level];
+      if ((code >> (levels_ - level - 1)) & 1u) {
+        count += bits.RankZero(right) - bits.RankZero(left);
+        left = levels_zeros_[level] + bits.RankOne(left);
+        right = levels_zeros_[level] + bits.RankOne(right);
+      } else {
+        left = bits.RankZero(left);
+        right = bits.RankZero(right);
+      }
+    }
+    return count;
+  }
+
+  size_t GetCode(const T &value) const {
+    return std::lower_bound(distinct_values_.begin(), distinct_values_.end(), value) - distinct_values_.begin();
+  }
+
+ public:
+  explicit WaveletMatrix(const std::vector<T> &values) : distinct_values_(values), levels_(1) {
+    std::sort(distinct_values_.begin(), distinct_values_.end());
+    distinct_values_.erase(std::unique(distinct_values_.begin(), distinct_values_.end()), distinct_values_.end());
+    while ((size_t(1) << levels_) < distinct_values_.size()) {
+      ++levels_;
+    }
+    std::vector<size_t> codes(values.size());
+    for (size_t i = 0; i < values.size(); ++i) {
+      codes[i] = GetCode(values[i]);
+    }
+    std::vector<size_t> next_codes(values.size());
+    for (size_t level = 0; level < levels_; ++level) {
+      const size_t shift = levels_ - level - 1;
+      BitVector bits(values.size());
+      std::vector<size_t> ones;
+      size_t zeros = 0;
+      for (size_t i = 0; i < codes.size(); ++i) {
+        if ((codes[i] >> shift) & 1u) {
+          bits.SetBit(i);
+          ones.push_back(codes[i]);
+        } else {
+          next_codes[zeros++] = codes[i];
+        }
+      }
+      std::copy(ones.begin(), ones.end(), next_codes.begin() + zeros);
+      bits.BuildRank();
+      levels_bits_.push_back(bits);
+      levels_zeros_.push_back(zeros);
+      codes.swap(next_codes);
+    }
+  }
+
+  // k-th (from 0) smallest value among values[left..right].
+  T KthSmallest(size_t left, size_t right, size_t k) const {
+    ++right;
+    size_t code = 0;
+    for (size_t level = 0; level < levels_; ++level) {
+      const BitVector &bits = levels_bits_[level];
+      const size_t zeros = bits.RankZero(right) - bits.RankZero(left);
+      code <<= 1u;
+      if (k < zeros) {
+        left = bits.RankZero(left);
+        right = bits.RankZero(right);
+      } else {
+        k -= zeros;
+        code |= 1u;
+        left = levels_zeros_[level] + bits.RankOne(left);
+        right = levels_zeros_[level] + bits.RankOne(right);
+      }
+    }
+    return distinct_values_[code];
+  }
+
+  // Number of values less than value among values[left..right].
+  size_t CountLess(size_t left, size_t right, const T &value) const {
+    return CountLessCode(left, right + 1, GetCode(value));
+  }
+
+  // Number of values in [lower, upper) among values[left..right].
+  size_t CountInRange(size_t left, size_t right, const T &lower, const T &upper) const {
+    if (!(lower < upper)) {
+      return 0;
+    }
+    return CountLessCode(left, right + 1, GetCode(upper)) - CountLessCode(left, right + 1, GetCode(lower));
+  }
+
+  size_t Frequency(size_t left, size_t right, const T &value) const {
+    const size_t code = GetCode(value);
+    if (code == distinct_values_.size() || value < distinct_values_[code]) {
+      return 0;
+    }
+    return CountLessCode(left, right + 1, code + 1) - CountLessCode(left, right + 1, code);
   }
 };
 
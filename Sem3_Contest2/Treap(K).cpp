@@ -49,9 +49,10 @@ none
 #include <iostream>
 #include <vector>
 #include <random>
-#include <memory>
+#include <cstdint>
 #include <ctime>
 #include <string>
+#include <algorithm>
 
 ////////////////////////////// class SetInterface //////////////////////////////
 
@@ -67,27 +68,36 @@ class SetInterface {
 
 ////////////////////////////// class Treap (Declaration) //////////////////////////////
 
+/* Nodes live in one vector and refer to each other by 32-bit indices; index NULL_NODE is a sentinel of size 0, so
+ sizes are read without checks. Removed nodes go to a free list and are reused by the next Insert. */
 template<typename KeyType>
 class Treap : public SetInterface<KeyType> {
  private:
   struct TreapNode;
+  using NodeIndex = uint32_t;
+  static constexpr NodeIndex NULL_NODE = 0;
+
   std::mt19937 random_priority_generator;
-  mutable std::shared_ptr<TreapNode> root_;
+  mutable std::vector<TreapNode> nodes_;
+  std::vector<NodeIndex> free_nodes_;
+  mutable NodeIndex root_;
+
+  bool FindKey(const KeyType &key, NodeIndex treap_node) const;
 
-  bool FindKey(const KeyType &key, std::shared_ptr<TreapNode> treap_node) const;
+  std::pair<NodeIndex, NodeIndex> Split(NodeIndex node, const KeyType &key) const;
 
-  static std::pair<std::shared_ptr<TreapNode>, std::shared_ptr<TreapNode>> Split(std::shared_ptr<TreapNode> node,
-                                                                                 const KeyType &key);
+  NodeIndex Merge(NodeIndex left_node, NodeIndex right_node) const;
 
-  static std::shared_ptr<TreapNode> Merge(std::shared_ptr<TreapNode> left_node,
-                                          std::shared_ptr<TreapNode> right_node);
+  KeyType GetKthSmallestElement(NodeIndex treap_node, size_t k) const;
 
-  KeyType GetKthSmallestElement(std::shared_ptr<TreapNode> treap_node, size_t k) const;
+  NodeIndex NewNode(const KeyType &key, int priority);
+
+  void UpdateSize(NodeIndex treap_node) const;
 
   int GenerateRandomPriority();
 
  public:
-  Treap() = default;
+  Treap();
 
   bool FindKey(const KeyType &key) const override;
 
@@ -112,83 +122,91 @@ struct Treap<KeyType>::TreapNode {
 
   int priority_;
 
-  size_t size_;
+  uint32_t size_;
 
-  std::shared_ptr<TreapNode> left_child_;
+  NodeIndex left_child_;
 
-  std::shared_ptr<TreapNode> right_child_;
-  explicit TreapNode() = default;
+  NodeIndex right_child_;
+  explicit TreapNode() : key_(), priority_(0), size_(0), left_child_(NULL_NODE), right_child_(NULL_NODE) {}
 
-  explicit TreapNode(const KeyType &key, const int priority, const size_t size = 1)
-      : key_(key), priority_(priority), size_(size) {}
+  explicit TreapNode(const KeyType &key, const int priority, const uint32_t size = 1)
+      : key_(key), priority_(priority), size_(size), left_child_(NULL_NODE), right_child_(NULL_NODE) {}
 
   enum class ChildType {
     LeftChild,
     RightChild
   };
 
-  void SetChild(std::shared_ptr<TreapNode> child, const ChildType &child_type) {
+  void SetChild(NodeIndex child, const ChildType &child_type) {
     if (child_type == ChildType::LeftChild) {
       left_child_ = child;
     } else {
       right_child_ = child;
     }
   }
-
-  static size_t GetSize(std::shared_ptr<TreapNode> treap_node) {
-    return treap_node ? treap_node->size_ : 0;
-  }
-
-  static void UpdateSize(std::shared_ptr<TreapNode> treap_node) {
-    if (treap_node == nullptr) {
-      return;
-    }
-    treap_node->size_ = GetSize(treap_node->left_child_) + GetSize(treap_node->right_child_) + 1;
-  }
 };
 
 
 ////////////////////////////// class Treap (Implementation) //////////////////////////////
 
+template<typename KeyType>
+Treap<KeyType>::Treap() : nodes_(1), root_(NULL_NODE) {}
+
 template<typename KeyType>
 int Treap<KeyType>::GenerateRandomPriority() {
   return random_priority_generator();
 }
 
 template<typename KeyType>
-std::shared_ptr<typename Treap<KeyType>::TreapNode>
-Treap<KeyType>::Merge(std::shared_ptr<TreapNode> left_node,
-                      std::shared_ptr<TreapNode> right_node) {
-  if (left_node == nullptr || right_node == nullptr) {
-    return (left_node != nullptr) ? left_node : right_node;
+typename Treap<KeyType>::NodeIndex Treap<KeyType>::NewNode(const KeyType &key, int priority) {
+  if (free_nodes_.empty()) {
+    nodes_.emplace_back(key, priority);
+    return static_cast<NodeIndex>(nodes_.size() - 1);
   }
-  if (left_node->priority_ < right_node->priority_) {
-    right_node->SetChild(Merge(left_node, right_node->left_child_), TreapNode::ChildType::LeftChild);
-    TreapNode::UpdateSize(right_node);
+  const NodeIndex node = free_nodes_.back();
+  free_nodes_.pop_back();
+  nodes_[node] = TreapNode(key, priority);
+  return node;
+}
+
+template<typename KeyType>
+void Treap<KeyType>::UpdateSize(NodeIndex treap_node) const {
+  TreapNode &node = nodes_[treap_node];
+  node.size_ = nodes_[node.left_child_].size_ + nodes_[node.right_child_].size_ + 1;
+}
+
+template<typename KeyType>
+typename Treap<KeyType>::NodeIndex Treap<KeyType>::Merge(NodeIndex left_node, NodeIndex right_node) const {
+  if (left_node == NULL_NODE || right_node == NULL_NODE) {
+    return (left_node != NULL_NODE) ? left_node : right_node;
+  }
+  if (nodes_[left_node].priority_ < nodes_[right_node].priority_) {
+    const NodeIndex child = Merge(left_node, nodes_[right_node].left_child_);
+    nodes_[right_node].SetChild(child, TreapNode::ChildType::LeftChild);
+    UpdateSize(right_node);
     return right_node;
   } else {
-    left_node->SetChild(Merge(left_node->right_child_, right_node), TreapNode::ChildType::RightChild);
-    TreapNode::UpdateSize(left_node);
+    const NodeIndex child = Merge(nodes_[left_node].right_child_, right_node);
+    nodes_[left_node].SetChild(child, TreapNode::ChildType::RightChild);
+    UpdateSize(left_node);
     return left_node;
   }
 }
 
 template<typename KeyType>
-std::pair<std::shared_ptr<typename Treap<KeyType>::TreapNode>,
-          std::shared_ptr<typename Treap<KeyType>::TreapNode>>
-Treap<KeyType>::Split(std::shared_ptr<TreapNode> node,
-                      const KeyType &key) {
-  if (node == nullptr) {
-    return {nullptr, nullptr};
-  } else if (key < node->key_) {
-    auto[left_node, right_node] = Split(node->left_child_, key);
-    node->SetChild(right_node, TreapNode::ChildType::LeftChild);
-    TreapNode::UpdateSize(node);
+std::pair<typename Treap<KeyType>::NodeIndex, typename Treap<KeyType>::NodeIndex>
+Treap<KeyType>::Split(NodeIndex node, const KeyType &key) const {
+  if (node == NULL_NODE) {
+    return {NULL_NODE, NULL_NODE};
+  } else if (key < nodes_[node].key_) {
+    auto[left_node, right_node] = Split(nodes_[node].left_child_, key);
+    nodes_[node].SetChild(right_node, TreapNode::ChildType::LeftChild);
+    UpdateSize(node);
     return {left_node, node};
   } else {
-    auto[left_node, right_node] = Split(node->right_child_, key);
-    node->SetChild(left_node, TreapNode::ChildType::RightChild);
-    TreapNode::UpdateSize(node);
+    auto[left_node, right_node] = Split(nodes_[node].right_child_, key);
+    nodes_[node].SetChild(left_node, TreapNode::ChildType::RightChild);
+    UpdateSize(node);
     return {node, right_node};
   }
 }
@@ -209,7 +227,7 @@ void Treap<KeyType>::Insert(const KeyType &key, int priority) {
     return;
   }
   auto[left_node, right_node] = Split(root_, key);
-  std::shared_ptr<TreapNode> new_node = std::make_shared<TreapNode>(key, priority);
+  const NodeIndex new_node = NewNode(key, priority);
   root_ = Merge(Merge(left_node, new_node), right_node);
 }
 
@@ -220,6 +238,7 @@ void Treap<KeyType>::Remove(const KeyType &key) {
   }
   auto[left_node, right_node] = Split(root_, key);
   auto[new_left_node, new_right_node] = Split(left_node, key - 1);
+  free_nodes_.push_back(new_right_node);
   root_ = Merge(new_left_node, right_node);
 }
 
@@ -228,14 +247,14 @@ KeyType Treap<KeyType>::LowerBound(const KeyType &key) const {
   constexpr KeyType NOT_SET(-1);
   auto[left_node, right_node] = Split(root_, key);
   auto move_left = right_node;
-  if (right_node == nullptr) {
+  if (right_node == NULL_NODE) {
     return NOT_SET;
   }
-  while (move_left->left_child_) {
-    move_left = move_left->left_child_;
+  while (nodes_[move_left].left_child_ != NULL_NODE) {
+    move_left = nodes_[move_left].left_child_;
   }
   root_ = Merge(left_node, right_node);
-  return move_left->key_;
+  return nodes_[move_left].key_;
 }
 
 template<typename KeyType>
@@ -243,43 +262,43 @@ KeyType Treap<KeyType>::UpperBound(const KeyType &key) const {
   constexpr KeyType NOT_SET(-1);
   auto[left_node, right_node] = Split(root_, key - 1);
   auto move_right = left_node;
-  if (left_node == nullptr) {
+  if (left_node == NULL_NODE) {
     return NOT_SET;
   }
-  while (move_right->right_child_) {
-    move_right = move_right->right_child_;
+  while (nodes_[move_right].right_child_ != NULL_NODE) {
+    move_right = nodes_[move_right].right_child_;
   }
   root_ = Merge(left_node, right_node);
-  return move_right->key_;
+  return nodes_[move_right].key_;
 }
 
 template<typename KeyType>
-bool Treap<KeyType>::FindKey(const KeyType &key, std::shared_ptr<TreapNode> treap_node) const {
-  if (treap_node == nullptr) {
+bool Treap<KeyType>::FindKey(const KeyType &key, NodeIndex treap_node) const {
+  if (treap_node == NULL_NODE) {
     return false;
   }
-  if (key == treap_node->key_) {
+  if (key == nodes_[treap_node].key_) {
     return true;
-  } else if (key < treap_node->key_) {
-    return FindKey(key, treap_node->left_child_);
+  } else if (key < nodes_[treap_node].key_) {
+    return FindKey(key, nodes_[treap_node].left_child_);
   } else {
-    return FindKey(key, treap_node->right_child_);
+    return FindKey(key, nodes_[treap_node].right_child_);
   }
 }
 
 template<typename KeyType>
-KeyType Treap<KeyType>::GetKthSmallestElement(std::shared_ptr<TreapNode> treap_node, size_t k) const {
+KeyType Treap<KeyType>::GetKthSmallestElement(NodeIndex treap_node, size_t k) const {
   constexpr KeyType NOT_SET(-1);
-  if (treap_node == nullptr) {
+  if (treap_node == NULL_NODE) {
     return NOT_SET;
   }
-  const size_t left_side_size = TreapNode::GetSize(treap_node->left_child_);
+  const size_t left_side_size = nodes_[nodes_[treap_node].left_child_].size_;
   if (left_side_size == k - 1) {
-    return treap_node->key_;
+    return nodes_[treap_node].key_;
   } else if (left_side_size < k - 1) {
-    return GetKthSmallestElement(treap_node->right_child_, k - left_side_size - 1);
+    return GetKthSmallestElement(nodes_[treap_node].right_child_, k - left_side_size - 1);
   } else {
-    return GetKthSmallestElement(treap_node->left_child_, k);
+    return GetKthSmallestElement(nodes_[treap_node].left_child_, k);
   }
 }
 
@@ -288,6 +307,185 @@ KeyType Treap<KeyType>::GetKthSmallestElement(size_t k) const {
   return GetKthSmallestElement(root_, k);
 }
 
+////////////////////////////// class FenwickTree (Declaration) //////////////////////////////
+
+// Prefix sums over [0, size) with non-negative values; tree_[i] holds the sum over [i & (i + 1), i].
+template<typename T>
+class FenwickTree {
+ private:
+  std::vector<T> tree_;
+
+ public:
+  explicit FenwickTree(size_t size);
+
+  explicit FenwickTree(const std::vector<T> &values);
+
+  void Update(size_t idx, const T &delta);
+
+  T PrefixSum(int64_t idx) const;
+
+  size_t LowerBound(T value) const;
+
+  size_t Size() const;
+};
+
+////////////////////////////// class FenwickSet (Declaration) //////////////////////////////
+
+// Set of keys from the dense range [0, universe_size): a Fenwick tree over 0/1 counts, k-th key by descent.
+template<typename KeyType>
+class FenwickSet : public SetInterface<KeyType> {
+ private:
+  FenwickTree<int64_t> counts_;
+  std::vector<bool> is_present_;
+  size_t size_;
+
+  static std::vector<int64_t> BuildCounts(size_t universe_size, const std::vector<KeyType> &keys);
+
+ public:
+  explicit FenwickSet(size_t universe_size);
+
+  FenwickSet(size_t universe_size, const std::vector<KeyType> &keys);
+
+  bool FindKey(const KeyType &key) const override;
+
+  void Insert(const KeyType &key) override;
+
+  void Remove(const KeyType &key) override;
+
+  KeyType LowerBound(const KeyType &key) const;
+
+  KeyType UpperBound(const KeyType &key) const;
+
+  KeyType GetKthSmallestElement(size_t k) const;
+};
+
+////////////////////////////// class FenwickTree (Implementation) //////////////////////////////
+
+template<typename T>
+FenwickTree<T>::FenwickTree(size_t size) : tree_(size, T(0)) {}
+
+// Every node adds its finished sum into its parent i | (i + 1), which comes later, so one pass builds the tree.
+template<typename T>
+FenwickTree<T>::FenwickTree(const std::vector<T> &values) : tree_(values) {
+  for (size_t i = 0; i < tree_.size(); ++i) {
+    const size_t parent = (i | (i + 1));
+    if (parent < tree_.size()) {
+      tree_[parent] += tree_[i];
+    }
+  }
+}
+
+template<typename T>
+void FenwickTree<T>::Update(size_t idx, const T &delta) {
+  for (size_t i = idx; i < tree_.size(); i = (i | (i + 1))) {
+    tree_[i] += delta;
+  }
+}
+
+template<typename T>
+T FenwickTree<T>::PrefixSum(int64_t idx) const {
+  T sum = 0;
+  for (int64_t i = std::min<int64_t>(idx, tree_.size() - 1); i >= 0; i = ((i & (i + 1)) - 1)) {
+    sum += tree_[i];
+  }
+  return sum;
+}
+
+/* Smallest idx with PrefixSum(idx) >= value, or Size() if there is none. Binary lifting: prefix holds the length of
+ a prefix whose sum is still below value, and node prefix + step - 1 covers exactly the next step elements. */
+template<typename T>
+size_t FenwickTree<T>::LowerBound(T value) const {
+  size_t step = 1;
+  while (step * 2 <= tree_.size()) {
+    step *= 2;
+  }
+  size_t prefix = 0;
+  for (; step > 0; step /= 2) {
+    if (prefix + step <= tree_.size() && tree_[prefix + step - 1] < value) {
+      prefix += step;
+      value -= tree_[prefix - 1];
+    }
+  }
+  return prefix;
+}
+
+template<typename T>
+size_t FenwickTree<T>::Size() const {
+  return tree_.size();
+}
+
+////////////////////////////// class FenwickSet (Implementation) //////////////////////////////
+
+template<typename KeyType>
+FenwickSet<KeyType>::FenwickSet(size_t universe_size)
+    : counts_(universe_size), is_present_(universe_size, false), size_(0) {}
+
+template<typename KeyType>
+FenwickSet<KeyType>::FenwickSet(size_t universe_size, const std::vector<KeyType> &keys)
+    : counts_(BuildCounts(universe_size, keys)), is_present_(universe_size, false), size_(0) {
+  for (const KeyType &key : keys) {
+    if (!is_present_[key]) {
+      is_present_[key] = true;
+      ++size_;
+    }
+  }
+}
+
+template<typename KeyType>
+std::vector<int64_t> FenwickSet<KeyType>::BuildCounts(size_t universe_size, const std::vector<KeyType> &keys) {
+  std::vector<int64_t> counts(universe_size, 0);
+  for (const KeyType &key : keys) {
+    counts[key] = 1;
+  }
+  return counts;
+}
+
+template<typename KeyType>
+bool FenwickSet<KeyType>::FindKey(const KeyType &key) const {
+  return is_present_[key];
+}
+
+template<typename KeyType>
+void FenwickSet<KeyType>::Insert(const KeyType &key) {
+  if (is_present_[key]) {
+    return;
+  }
+  is_present_[key] = true;
+  ++size_;
+  counts_.Update(key, 1);
+}
+
+template<typename KeyType>
+void FenwickSet<KeyType>::Remove(const KeyType &key) {
+  if (!is_present_[key]) {
+    return;
+  }
+  is_present_[key] = false;
+  --size_;
+  counts_.Update(key, -1);
+}
+
+template<typename KeyType>
+KeyType FenwickSet<KeyType>::LowerBound(const KeyType &key) const {
+  return GetKthSmallestElement(counts_.PrefixSum(key) + 1);
+}
+
+template<typename KeyType>
+KeyType FenwickSet<KeyType>::UpperBound(const KeyType &key) const {
+  constexpr KeyType NOT_SET(-1);
+  const int64_t smaller_count = counts_.PrefixSum(key - 1);
+  return (smaller_count == 0) ? NOT_SET : GetKthSmallestElement(smaller_count);
+}
+
+template<typename KeyType>
+KeyType FenwickSet<KeyType>::GetKthSmallestElement(size_t k) const {
+  constexpr KeyType NOT_SET(-1);
+  if (k == 0 || k > size_) {
+    return NOT_SET;
+  }
+  return static_cast<KeyType>(counts_.LowerBound(static_cast<int64_t>(k)));
+}
+
 int main() {
   Treap<int64_t> treap;
   std::string query;
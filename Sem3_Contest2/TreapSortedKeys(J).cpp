@@ -41,7 +41,8 @@ YES
 #include <vector>
 #include <algorithm>
 #include <random>
-#include <memory>
+#include <cstdint>
+#include <iterator>
 #include <ctime>
 #include <string>
 
@@ -58,29 +59,37 @@ struct Node {
 
 ////////////////////////////// class Treap (Declaration) //////////////////////////////
 
+/* Nodes live in one vector and refer to each other by 32-bit indices, parents included. Index NULL_NODE is a sentinel
+ with number 0, which is exactly what PrintTreap outputs for a missing parent or child. */
 template<typename KeyType, typename PriorityType>
 class Treap {
  private:
   struct TreapNode;
-  std::shared_ptr<TreapNode> root_;
+  using NodeIndex = uint32_t;
+  static constexpr NodeIndex NULL_NODE = 0;
+
+  std::vector<TreapNode> nodes_;
+  NodeIndex root_;
   struct TreapNodeInfo {
     size_t parent_num;
     size_t left_child_num;
     size_t right_child_num;
   };
 
-  bool FindKey(const KeyType &key, std::shared_ptr<TreapNode> treap_node) const;
+  bool FindKey(const KeyType &key, NodeIndex treap_node) const;
+
+  std::pair<NodeIndex, NodeIndex> Split(NodeIndex node, const KeyType &key);
+
+  NodeIndex Merge(NodeIndex left_node, NodeIndex right_node);
 
-  static std::pair<std::shared_ptr<TreapNode>, std::shared_ptr<TreapNode>> Split(std::shared_ptr<TreapNode> node,
-                                                                                 const KeyType &key);
+  NodeIndex NewNode(const KeyType &key, const PriorityType &priority, size_t num);
 
-  static std::shared_ptr<TreapNode> Merge(std::shared_ptr<TreapNode> left_node,
-                                          std::shared_ptr<TreapNode> right_node);
+  void SetChild(NodeIndex node, NodeIndex child, const typename TreapNode::ChildType &child_type);
 
-  void GetTreapNodeInfo(std::shared_ptr<TreapNode> node, std::vector<TreapNodeInfo> &treap_nodes_info) const;
+  void GetTreapNodeInfo(NodeIndex node, std::vector<TreapNodeInfo> &treap_nodes_info) const;
 
  public:
-  Treap() = default;
+  Treap();
 
   template<typename Iter>
   Treap(Iter begin, Iter end);
@@ -89,8 +98,7 @@ class Treap {
 
   void Insert(const KeyType &key, const PriorityType &priority, size_t num);
 
-  void InsertSortedOrder(const KeyType &key, const PriorityType &priority, size_t num,
-                         std::shared_ptr<TreapNode> &last_pushed);
+  void InsertSortedOrder(const KeyType &key, const PriorityType &priority, size_t num, NodeIndex &last_pushed);
 
   void PrintTreap(size_t num) const;
 };
@@ -98,46 +106,41 @@ class Treap {
 ////////////////////////////// class TreapNode //////////////////////////////
 
 template<typename KeyType, typename PriorityType>
-struct Treap<KeyType, PriorityType>::TreapNode : public std::enable_shared_from_this<TreapNode> {
+struct Treap<KeyType, PriorityType>::TreapNode {
   KeyType key_;
 
   PriorityType priority_;
 
   size_t num_;
 
-  std::shared_ptr<TreapNode> left_child_;
+  NodeIndex left_child_;
 
-  std::shared_ptr<TreapNode> right_child_;
+  NodeIndex right_child_;
 
-  std::weak_ptr<TreapNode> parent_;
+  NodeIndex parent_;
 
-  explicit TreapNode() = default;
+  explicit TreapNode()
+      : key_(), priority_(), num_(0), left_child_(NULL_NODE), right_child_(NULL_NODE), parent_(NULL_NODE) {}
 
   explicit TreapNode(const KeyType &key, const PriorityType &priority, size_t num)
-      : key_(key), priority_(priority), num_(num) {}
+      : key_(key), priority_(priority), num_(num), left_child_(NULL_NODE), right_child_(NULL_NODE),
+        parent_(NULL_NODE) {}
 
   enum class ChildType {
     LeftChild,
     RightChild
   };
-
-  void SetChild(std::shared_ptr<TreapNode> child, const ChildType &child_type) {
-    if (child_type == ChildType::LeftChild) {
-      left_child_ = child;
-    } else {
-      right_child_ = child;
-    }
-    if (child != nullptr) {
-      child->parent_ = this->shared_from_this();
-    }
-  }
 };
 
 ////////////////////////////// class Treap (Implementation) //////////////////////////////
+template<typename KeyType, typename PriorityType>
+Treap<KeyType, PriorityType>::Treap() : nodes_(1), root_(NULL_NODE) {}
+
 template<typename KeyType, typename PriorityType>
 template<typename Iter>
 Treap<KeyType, PriorityType>::Treap(Iter begin, Iter end) : Treap() {
-  std::shared_ptr<TreapNode> last_pushed = nullptr;
+  nodes_.reserve(std::distance(begin, end) + 1);
+  NodeIndex last_pushed = NULL_NODE;
   if (!std::is_sorted(begin, end)) {
     for (auto iter = begin; iter != end; ++iter) {
       Insert(iter->key, iter->priority, iter->num);
@@ -150,46 +153,58 @@ Treap<KeyType, PriorityType>::Treap(Iter begin, Iter end) : Treap() {
 }
 
 template<typename KeyType, typename PriorityType>
-std::shared_ptr<typename Treap<KeyType, PriorityType>::TreapNode>
-Treap<KeyType, PriorityType>::Merge(std::shared_ptr<TreapNode> left_node,
-                                    std::shared_ptr<TreapNode> right_node) {
-  if (left_node == nullptr || right_node == nullptr) {
-    return (left_node != nullptr) ? left_node : right_node;
+typename Treap<KeyType, PriorityType>::NodeIndex
+Treap<KeyType, PriorityType>::NewNode(const KeyType &key, const PriorityType &priority, size_t num) {
+  nodes_.emplace_back(key, priority, num);
+  return static_cast<NodeIndex>(nodes_.size() - 1);
+}
+
+template<typename KeyType, typename PriorityType>
+void Treap<KeyType, PriorityType>::SetChild(NodeIndex node, NodeIndex child,
+                                            const typename TreapNode::ChildType &child_type) {
+  if (child_type == TreapNode::ChildType::LeftChild) {
+    nodes_[node].left_child_ = child;
+  } else {
+    nodes_[node].right_child_ = child;
+  }
+  if (child != NULL_NODE) {
+    nodes_[child].parent_ = node;
+  }
+}
+
+template<typename KeyType, typename PriorityType>
+typename Treap<KeyType, PriorityType>::NodeIndex
+Treap<KeyType, PriorityType>::Merge(NodeIndex left_node, NodeIndex right_node) {
+  if (left_node == NULL_NODE || right_node == NULL_NODE) {
+    return (left_node != NULL_NODE) ? left_node : right_node;
   }
-  if (left_node->priority_ < right_node->priority_) {
-    right_node->SetChild(Merge(left_node, right_node->left_child_), TreapNode::ChildType::LeftChild);
+  if (nodes_[left_node].priority_ < nodes_[right_node].priority_) {
+    SetChild(right_node, Merge(left_node, nodes_[right_node].left_child_), TreapNode::ChildType::LeftChild);
     return right_node;
   } else {
-    left_node->SetChild(Merge(left_node->right_child_, right_node), TreapNode::ChildType::RightChild);
+    SetChild(left_node, Merge(nodes_[left_node].right_child_, right_node), TreapNode::ChildType::RightChild);
     return left_node;
   }
 }
 
+// The part split off from node loses its parent; the other one is attached to node by SetChild.
 template<typename KeyType, typename PriorityType>
-std::pair<std::shared_ptr<typename Treap<KeyType, PriorityType>::TreapNode>,
-          std::shared_ptr<typename Treap<KeyType, PriorityType>::TreapNode>>
-Treap<KeyType, PriorityType>::Split(std::shared_ptr<TreapNode> node,
-                                    const KeyType &key) {
-  if (node == nullptr) {
-    return {nullptr, nullptr};
-  } else if (key < node->key_) {
-    auto[left_node, right_node] = Split(node->left_child_, key);
-    node->SetChild(right_node, TreapNode::ChildType::LeftChild);
-    if (left_node) {
-      left_node->parent_.lock() = nullptr;
-    }
-    if (right_node) {
-      right_node->parent_ = node;
+std::pair<typename Treap<KeyType, PriorityType>::NodeIndex, typename Treap<KeyType, PriorityType>::NodeIndex>
+Treap<KeyType, PriorityType>::Split(NodeIndex node, const KeyType &key) {
+  if (node == NULL_NODE) {
+    return {NULL_NODE, NULL_NODE};
+  } else if (key < nodes_[node].key_) {
+    auto[left_node, right_node] = Split(nodes_[node].left_child_, key);
+    SetChild(node, right_node, TreapNode::ChildType::LeftChild);
+    if (left_node != NULL_NODE) {
+      nodes_[left_node].parent_ = NULL_NODE;
     }
     return {left_node, node};
   } else {
-    auto[left_node, right_node] = Split(node->right_child_, key);
-    node->SetChild(left_node, TreapNode::ChildType::RightChild);
-    if (left_node) {
-      left_node->parent_ = node;
-    }
-    if (right_node) {
-      right_node->parent_.lock() = nullptr;
+    auto[left_node, right_node] = Split(nodes_[node].right_child_, key);
+    SetChild(node, left_node, TreapNode::ChildType::RightChild);
+    if (right_node != NULL_NODE) {
+      nodes_[right_node].parent_ = NULL_NODE;
     }
     return {node, right_node};
   }
@@ -206,7 +221,7 @@ void Treap<KeyType, PriorityType>::Insert(const KeyType &key, const PriorityType
     return;
   }
   auto[left_node, right_node] = Split(root_, key);
-  std::shared_ptr<TreapNode> new_node = std::make_shared<TreapNode>(key, priority, num);
+  const NodeIndex new_node = NewNode(key, priority, num);
   root_ = Merge(Merge(left_node, new_node), right_node);
 }
 
@@ -214,53 +229,53 @@ template<typename KeyType, typename PriorityType>
 void Treap<KeyType, PriorityType>::InsertSortedOrder(const KeyType &key,
                                                      const PriorityType &priority,
                                                      size_t num,
-                                                     std::shared_ptr<TreapNode> &last_pushed) {
-  std::shared_ptr<TreapNode> current_node = last_pushed;
-  if (root_ == nullptr) {
+                                                     NodeIndex &last_pushed) {
+  if (root_ == NULL_NODE) {
     Insert(key, priority, num);
     last_pushed = root_;
     return;
   }
-  current_node = last_pushed;
-  while (current_node && current_node->priority_ < priority) {
-    current_node = current_node->parent_.lock();
+  NodeIndex current_node = last_pushed;
+  while (current_node != NULL_NODE && nodes_[current_node].priority_ < priority) {
+    current_node = nodes_[current_node].parent_;
   }
-  std::shared_ptr<TreapNode> new_node = std::make_shared<TreapNode>(key, priority, num);
-  if (current_node) {
-    new_node->SetChild(current_node->right_child_, TreapNode::ChildType::LeftChild);
-    current_node->SetChild(new_node, TreapNode::ChildType::RightChild);
+  const NodeIndex new_node = NewNode(key, priority, num);
+  if (current_node != NULL_NODE) {
+    SetChild(new_node, nodes_[current_node].right_child_, TreapNode::ChildType::LeftChild);
+    SetChild(current_node, new_node, TreapNode::ChildType::RightChild);
   } else {
-    new_node->SetChild(root_, TreapNode::ChildType::LeftChild);
+    SetChild(new_node, root_, TreapNode::ChildType::LeftChild);
     root_ = new_node;
   }
   last_pushed = new_node;
 }
 
 template<typename KeyType, typename PriorityType>
-bool Treap<KeyType, PriorityType>::FindKey(const KeyType &key, std::shared_ptr<TreapNode> treap_node) const {
-  if (treap_node == nullptr) {
+bool Treap<KeyType, PriorityType>::FindKey(const KeyType &key, NodeIndex treap_node) const {
+  if (treap_node == NULL_NODE) {
     return false;
   }
-  if (key == treap_node->key_) {
+  if (key == nodes_[treap_node].key_) {
     return true;
-  } else if (key < treap_node->key_) {
-    return FindKey(key, treap_node->left_child_);
+  } else if (key < nodes_[treap_node].key_) {
+    return FindKey(key, nodes_[treap_node].left_child_);
   } else {
-    return FindKey(key, treap_node->right_child_);
+    return FindKey(key, nodes_[treap_node].right_child_);
   }
 }
 
 template<typename KeyType, typename PriorityType>
-void Treap<KeyType, PriorityType>::GetTreapNodeInfo(std::shared_ptr<Treap<KeyType, PriorityType>::TreapNode> node,
+void Treap<KeyType, PriorityType>::GetTreapNodeInfo(NodeIndex node,
                                                     std::vector<TreapNodeInfo> &treap_nodes_info) const {
-  if (node == nullptr) {
+  if (node == NULL_NODE) {
     return;
   }
-  GetTreapNodeInfo(node->left_child_, treap_nodes_info);
-  treap_nodes_info[node->num_ - 1].parent_num = (node->parent_.lock() ? node->parent_.lock()->num_ : 0);
-  treap_nodes_info[node->num_ - 1].left_child_num = (node->left_child_ ? node->left_child_->num_ : 0);
-  treap_nodes_info[node->num_ - 1].right_child_num = (node->right_child_ ? node->right_child_->num_ : 0);
-  GetTreapNodeInfo(node->right_child_, treap_nodes_info);
+  const TreapNode &treap_node = nodes_[node];
+  GetTreapNodeInfo(treap_node.left_child_, treap_nodes_info);
+  treap_nodes_info[treap_node.num_ - 1].parent_num = nodes_[treap_node.parent_].num_;
+  treap_nodes_info[treap_node.num_ - 1].left_child_num = nodes_[treap_node.left_child_].num_;
+  treap_nodes_info[treap_node.num_ - 1].right_child_num = nodes_[treap_node.right_child_].num_;
+  GetTreapNodeInfo(treap_node.right_child_, treap_nodes_info);
 }
 
 template<typename KeyType, typename PriorityType>
@@ -30,7 +30,7 @@ Input	Output
 #include <iostream>
 #include <vector>
 #include <random>
-#include <memory>
+#include <cstdint>
 #include <ctime>
 #include <string>
 
@@ -48,27 +48,36 @@ class SetInterface {
 
 ////////////////////////////// class Treap (Declaration) //////////////////////////////
 
+/* Nodes live in one vector and refer to each other by 32-bit indices; index NULL_NODE is a sentinel with size and
+ sum 0, so subtree values are read without checks. Removed nodes go to a free list and are reused by Insert. */
 template<typename KeyType>
 class Treap : public SetInterface<KeyType> {
  private:
   struct TreapNode;
+  using NodeIndex = uint32_t;
+  static constexpr NodeIndex NULL_NODE = 0;
+
   std::mt19937 random_priority_generator;
-  std::shared_ptr<TreapNode> root_;
+  std::vector<TreapNode> nodes_;
+  std::vector<NodeIndex> free_nodes_;
+  NodeIndex root_;
+
+  bool FindKey(const KeyType &key, NodeIndex treap_node) const;
+
+  std::pair<NodeIndex, NodeIndex> Split(NodeIndex node, const KeyType &key);
 
-  bool FindKey(const KeyType &key, std::shared_ptr<TreapNode> treap_node) const;
+  NodeIndex Merge(NodeIndex left_node, NodeIndex right_node);
 
-  static std::pair<std::shared_ptr<TreapNode>, std::shared_ptr<TreapNode>> Split(std::shared_ptr<TreapNode> node,
-                                                                          const KeyType &key);
+  KeyType GetKthSmallestElement(NodeIndex treap_node, size_t k) const;
 
-  static std::shared_ptr<TreapNode> Merge(std::shared_ptr<TreapNode> left_node,
-                                   std::shared_ptr<TreapNode> right_node);
+  NodeIndex NewNode(const KeyType &key, int priority);
 
-  KeyType GetKthSmallestElement(std::shared_ptr<TreapNode> treap_node, size_t k) const;
+  void Update(NodeIndex treap_node);
 
   int GenerateRandomPriority();
 
  public:
-  explicit Treap() = default;
+  explicit Treap();
 
   bool FindKey(const KeyType &key) const override;
 
@@ -91,88 +100,93 @@ struct Treap<KeyType>::TreapNode {
 
   int priority_;
 
-  size_t size_;
+  uint32_t size_;
 
-  std::shared_ptr<TreapNode> left_child_;
+  NodeIndex left_child_;
 
-  std::shared_ptr<TreapNode> right_child_;
-  explicit TreapNode() = default;
+  NodeIndex right_child_;
+  explicit TreapNode()
+      : key_(), sum_(), priority_(0), size_(0), left_child_(NULL_NODE), right_child_(NULL_NODE) {}
 
-  explicit TreapNode(const KeyType &key, const int priority, const size_t size = 1)
-      : key_(key), priority_(priority), size_(size), sum_(key) {}
+  explicit TreapNode(const KeyType &key, const int priority, const uint32_t size = 1)
+      : key_(key), sum_(key), priority_(priority), size_(size), left_child_(NULL_NODE), right_child_(NULL_NODE) {}
 
   enum class ChildType {
     LeftChild,
     RightChild
   };
 
-  void SetChild(std::shared_ptr<TreapNode> child, const ChildType &child_type) {
+  void SetChild(NodeIndex child, const ChildType &child_type) {
     if (child_type == ChildType::LeftChild) {
       left_child_ = child;
     } else {
       right_child_ = child;
     }
   }
-
-  static size_t GetSize(std::shared_ptr<TreapNode> treap_node) {
-    return treap_node ? treap_node->size_ : 0;
-  }
-
-  static KeyType GetSum(std::shared_ptr<TreapNode> treap_node) {
-    return treap_node ? treap_node->sum_ : 0;
-  }
-
-  static void Update(std::shared_ptr<TreapNode> treap_node) {
-    if (treap_node == nullptr) {
-      return;
-    }
-    treap_node->size_ = GetSize(treap_node->left_child_) + GetSize(treap_node->right_child_) + 1;
-    treap_node->sum_ = GetSum(treap_node->left_child_) + GetSum(treap_node->right_child_) + treap_node->key_;
-  }
 };
 
 
 ////////////////////////////// class Treap (Implementation) //////////////////////////////
 
+template<typename KeyType>
+Treap<KeyType>::Treap() : nodes_(1), root_(NULL_NODE) {}
+
 template<typename KeyType>
 int Treap<KeyType>::GenerateRandomPriority() {
   return random_priority_generator();
 }
 
 template<typename KeyType>
-std::shared_ptr<typename Treap<KeyType>::TreapNode>
-Treap<KeyType>::Merge(std::shared_ptr<TreapNode> left_node,
-                      std::shared_ptr<TreapNode> right_node) {
-  if (left_node == nullptr || right_node == nullptr) {
-    return (left_node != nullptr) ? left_node : right_node;
+typename Treap<KeyType>::NodeIndex Treap<KeyType>::NewNode(const KeyType &key, int priority) {
+  if (free_nodes_.empty()) {
+    nodes_.emplace_back(key, priority);
+    return static_cast<NodeIndex>(nodes_.size() - 1);
+  }
+  const NodeIndex node = free_nodes_.back();
+  free_nodes_.pop_back();
+  nodes_[node] = TreapNode(key, priority);
+  return node;
+}
+
+template<typename KeyType>
+void Treap<KeyType>::Update(NodeIndex treap_node) {
+  TreapNode &node = nodes_[treap_node];
+  node.size_ = nodes_[node.left_child_].size_ + nodes_[node.right_child_].size_ + 1;
+  node.sum_ = nodes_[node.left_child_].sum_ + nodes_[node.right_child_].sum_ + node.key_;
+}
+
+template<typename KeyType>
+typename Treap<KeyType>::NodeIndex Treap<KeyType>::Merge(NodeIndex left_node, NodeIndex right_node) {
+  if (left_node == NULL_NODE || right_node == NULL_NODE) {
+    return (left_node != NULL_NODE) ? left_node : right_node;
   }
-  if (left_node->priority_ < right_node->priority_) {
-    right_node->SetChild(Merge(left_node, right_node->left_child_), TreapNode::ChildType::LeftChild);
-    TreapNode::Update(right_node);
+  if (nodes_[left_node].priority_ < nodes_[right_node].priority_) {
+    const NodeIndex child = Merge(left_node, nodes_[right_node].left_child_);
+    nodes_[right_node].SetChild(child, TreapNode::ChildType::LeftChild);
+    Update(right_node);
     return right_node;
   } else {
-    left_node->SetChild(Merge(left_node->right_child_, right_node), TreapNode::ChildType::RightChild);
-    TreapNode::Update(left_node);
+    const NodeIndex child = Merge(nodes_[left_node].right_child_, right_node);
+    nodes_[left_node].SetChild(child, TreapNode::ChildType::RightChild);
+    Update(left_node);
     return left_node;
   }
 }
 
 template<typename KeyType>
-std::pair<std::shared_ptr<typename Treap<KeyType>::TreapNode>,
-          std::shared_ptr<typename Treap<KeyType>::TreapNode>>
-Treap<KeyType>::Split(std::shared_ptr<TreapNode> node,
-                      const KeyType &key) {
-  if (node == nullptr) {
-    return {nullptr, nullptr};
-  } else if (key < node->key_) {
-    auto[left_node, right_node] = Split(node->left_child_, key);
-    node->SetChild(right_node, TreapNode::ChildType::LeftChild);
-    TreapNode::Update(node);
+std::pair<typename Treap<KeyType>::NodeIndex, typename Treap<KeyType>::NodeIndex>
+Treap<KeyType>::Split(NodeIndex node, const KeyType &key) {
+  if (node == NULL_NODE) {
+    return {NULL_NODE, NULL_NODE};
+  } else if (key < nodes_[node].key_) {
+    auto[left_node, right_node] = Split(nodes_[node].left_child_, key);
+    nodes_[node].SetChild(right_node, TreapNode::ChildType::LeftChild);
+    Update(node);
     return {left_node, node};
   } else {
-    auto[left_node, right_node] = Split(node->right_child_, key);
-    node->SetChild(left_node, TreapNode::ChildType::RightChild);
-    TreapNode::Update(node);
+    auto[left_node, right_node] = Split(nodes_[node].right_child_, key);
+    nodes_[node].SetChild(left_node, TreapNode::ChildType::RightChild);
+    Update(node);
     return {node, right_node};
   }
 }
@@ -193,7 +207,7 @@ void Treap<KeyType>::Insert(const KeyType &key, int priority) {
     return;
   }
   auto[left_node, right_node] = Split(root_, key);
-  std::shared_ptr<TreapNode> new_node = std::make_shared<TreapNode>(key, priority);
+  const NodeIndex new_node = NewNode(key, priority);
   root_ = Merge(Merge(left_node, new_node), right_node);
 }
 
@@ -204,20 +218,21 @@ void Treap<KeyType>::Remove(const KeyType &key) {
   }
   auto[left_node, right_node] = Split(root_, key);
   auto[new_left_node, new_right_node] = Split(left_node, key - 1);
+  free_nodes_.push_back(new_right_node);
   root_ = Merge(new_left_node, right_node);
 }
 
 template<typename KeyType>
-bool Treap<KeyType>::FindKey(const KeyType &key, std::shared_ptr<TreapNode> treap_node) const {
-  if (treap_node == nullptr) {
+bool Treap<KeyType>::FindKey(const KeyType &key, NodeIndex treap_node) const {
+  if (treap_node == NULL_NODE) {
     return false;
   }
-  if (key == treap_node->key_) {
+  if (key == nodes_[treap_node].key_) {
     return true;
-  } else if (key < treap_node->key_) {
-    return FindKey(key, treap_node->left_child_);
+  } else if (key < nodes_[treap_node].key_) {
+    return FindKey(key, nodes_[treap_node].left_child_);
   } else {
-    return FindKey(key, treap_node->right_child_);
+    return FindKey(key, nodes_[treap_node].right_child_);
   }
 }
 
@@ -225,7 +240,7 @@ template<typename KeyType>
 KeyType Treap<KeyType>::GetSum(const KeyType &left, const KeyType &right){
   auto[first_left_node, first_right_node] = Split(root_, right);
   auto[second_left_node, second_right_node] = Split(first_left_node, left - 1);
-  KeyType result_sum = TreapNode::GetSum(second_right_node);
+  KeyType result_sum = nodes_[second_right_node].sum_;
   root_ = Merge(Merge(second_left_node, second_right_node), first_right_node);
   return result_sum;
 }